@@ -34,10 +34,8 @@
 
 #include <libecs/ecs.hpp>
 
-// #include <basic/delegate.hpp>
 // #include <basic/logger.hpp>
 // #include <basic/sparse_set.hpp>
-// #include <basic/taskgraph.hpp>
 
 // #include <assets/scripts/camera_controller.hpp>
 // #include <assets/scripts/player_controller.hpp>
@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <libecs/ecs.hpp>
+
+template<std::size_t Index>
+struct component {
+  float values[4]{1.0f, 1.0f, 1.0f, 1.0f};
+};
+
+using position = component<0>;
+using velocity = component<1>;
+using mass = component<2>;
+using health = component<3>;
+using damping = component<4>;
+using color = component<5>;
+
+inline constexpr auto entity_count = std::size_t{200000};
+inline constexpr auto iterations = std::size_t{50};
+inline constexpr auto frames = std::size_t{50};
+
+class stopwatch {
+
+public:
+
+  using clock_type = std::chrono::steady_clock;
+
+  stopwatch()
+  : _start{clock_type::now()} { }
+
+  auto lap() -> double {
+    const auto now = clock_type::now();
+    const auto elapsed = std::chrono::duration<double, std::milli>(now - _start);
+
+    _start = now;
+
+    return elapsed.count();
+  }
+
+private:
+
+  clock_type::time_point _start;
+
+}; // class stopwatch
+
+template<typename Registry>
+auto iterate(Registry& registry) -> float {
+  auto sum = 0.0f;
+
+  registry.template create_view<position, velocity, const mass, const damping>().each([&sum](position& p, velocity& v, const mass& m, const damping& d) {
+    p.values[0] += v.values[1] * m.values[2] + d.values[3];
+    sum += p.values[0];
+  });
+
+  return sum;
+}
+
+template<typename Registry>
+auto churn(Registry& registry, const std::vector<typename Registry::entity_type>& entities, const std::size_t offset) -> void {
+  for (auto index = offset; index < entities.size(); index += 10u) {
+    registry.template remove_component<health>(entities[index]);
+    registry.template add_component<health>(entities[index]);
+  }
+}
+
+template<typename Backend>
+auto run(const std::string_view name) -> void {
+  auto registry = ecs::registry_for<Backend>{};
+  auto entities = std::vector<typename decltype(registry)::entity_type>{};
+  auto checksum = 0.0f;
+
+  entities.reserve(entity_count);
+
+  auto watch = stopwatch{};
+
+  for (auto index = std::size_t{0}; index < entity_count; ++index) {
+    const auto entity = entities.emplace_back(registry.create_entity());
+
+    registry.template add_component<position>(entity);
+    registry.template add_component<velocity>(entity);
+    registry.template add_component<mass>(entity);
+
+    if (index % 2u != 0u) {
+      registry.template add_component<health>(entity);
+    }
+
+    if (index % 3u != 0u) {
+      registry.template add_component<damping>(entity);
+    }
+
+    if (index % 5u != 0u) {
+      registry.template add_component<color>(entity);
+    }
+  }
+
+  const auto create = watch.lap();
+
+  for (auto iteration = std::size_t{0}; iteration < iterations; ++iteration) {
+    checksum += iterate(registry);
+  }
+
+  const auto iterate_time = watch.lap();
+
+  for (auto offset = std::size_t{0}; offset < 5u; ++offset) {
+    churn(registry, entities, offset);
+  }
+
+  const auto churn_time = watch.lap();
+
+  for (auto frame = std::size_t{0}; frame < frames; ++frame) {
+    checksum += iterate(registry);
+    churn(registry, entities, frame % 10u);
+  }
+
+  const auto mixed = watch.lap();
+
+  fmt::print("{:<10} create {:>8.1f}ms | iterate x{} {:>8.1f}ms | add/remove {:>8.1f}ms | mixed x{} {:>8.1f}ms | checksum {}\n", name, create, iterations, iterate_time, churn_time, frames, mixed, checksum);
+}
+
+auto main() -> int {
+  fmt::print("{} entities\n", entity_count);
+
+  run<ecs::sparse_set_backend>("sparse set");
+  run<ecs::archetype_backend>("archetype");
+
+  return 0;
+}
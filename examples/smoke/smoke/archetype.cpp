@@ -0,0 +1,166 @@
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <libecs/ecs.hpp>
+
+#include "check.hpp"
+
+// [NOTE]: Counts live instances and owns heap memory, so a component that is moved without being destroyed, or destroyed twice, is detected
+struct tracked {
+  inline static auto alive = 0;
+
+  tracked(const int value)
+  : value{std::to_string(value)} {
+    ++alive;
+  }
+
+  tracked(const tracked& other)
+  : value{other.value} {
+    ++alive;
+  }
+
+  tracked(tracked&& other) noexcept
+  : value{std::move(other.value)} {
+    ++alive;
+  }
+
+  ~tracked() {
+    --alive;
+  }
+
+  auto operator=(const tracked&) -> tracked& = default;
+
+  auto operator=(tracked&&) noexcept -> tracked& = default;
+
+  std::string value;
+}; // struct tracked
+
+struct position {
+  int value;
+};
+
+struct velocity {
+  double value;
+};
+
+struct frozen { };
+
+struct model {
+  int tracked{-1};
+  int position{-1};
+  int velocity{-1};
+  bool frozen{false};
+}; // struct model
+
+auto check_registry(ecs::archetype_registry& registry, const std::unordered_map<ecs::entity, model>& models) -> void {
+  auto tracked_count = 0;
+
+  for (const auto& [entity, expected] : models) {
+    smoke::check(registry.is_valid_entity(entity));
+
+    smoke::check(registry.has_component<tracked>(entity) == (expected.tracked != -1));
+    smoke::check(registry.has_component<position>(entity) == (expected.position != -1));
+    smoke::check(registry.has_component<velocity>(entity) == (expected.velocity != -1));
+    smoke::check(registry.has_component<frozen>(entity) == expected.frozen);
+
+    if (expected.tracked != -1) {
+      smoke::check(registry.get_component<tracked>(entity)->value == std::to_string(expected.tracked));
+      ++tracked_count;
+    }
+
+    if (expected.position != -1) {
+      smoke::check(registry.get_component<position>(entity)->value == expected.position);
+    }
+
+    if (expected.velocity != -1) {
+      smoke::check(registry.get_component<velocity>(entity)->value == expected.velocity);
+    }
+  }
+
+  smoke::check(tracked::alive == tracked_count);
+
+  auto visited = std::size_t{0};
+
+  registry.create_view<position, tracked>(ecs::exclude<frozen>).each([&](const ecs::entity entity, position& p, tracked& t) {
+    const auto& expected = models.at(entity);
+
+    smoke::check(!expected.frozen && p.value == expected.position && t.value == std::to_string(expected.tracked));
+    ++visited;
+  });
+
+  auto expected_count = std::size_t{0};
+
+  for (const auto& [entity, expected] : models) {
+    expected_count += (expected.position != -1 && expected.tracked != -1 && !expected.frozen) ? 1u : 0u;
+  }
+
+  smoke::check(visited == expected_count);
+}
+
+auto main() -> int {
+  return smoke::run("archetype", []() {
+    {
+      auto registry = ecs::archetype_registry{};
+      auto models = std::unordered_map<ecs::entity, model>{};
+      auto entities = std::vector<ecs::entity>{};
+      auto random = std::minstd_rand{7u};
+
+      // [NOTE]: Enough entities to fill several chunks per archetype, so moves cross chunk boundaries
+      for (auto index = 0; index < 5000; ++index) {
+        const auto entity = registry.create_entity();
+        entities.push_back(entity);
+        models.emplace(entity, model{});
+      }
+
+      for (auto step = 0; step < 100000; ++step) {
+        auto& entity = entities[random() % entities.size()];
+        auto& expected = models.at(entity);
+        const auto value = static_cast<int>(random() % 1000u);
+
+        switch (random() % 9u) {
+          case 0u: registry.add_component<tracked>(entity, value); expected.tracked = value; break;
+          case 1u: registry.add_component<position>(entity, value); expected.position = value; break;
+          case 2u: registry.add_component<velocity>(entity, static_cast<double>(value)); expected.velocity = value; break;
+          case 3u: registry.add_component<frozen>(entity); expected.frozen = true; break;
+          case 4u: registry.remove_component<tracked>(entity); expected.tracked = -1; break;
+          case 5u: registry.remove_component<position>(entity); expected.position = -1; break;
+          case 6u: registry.remove_component<velocity>(entity); expected.velocity = -1; break;
+          case 7u: registry.remove_component<frozen>(entity); expected.frozen = false; break;
+          default: {
+            const auto stale = entity;
+
+            registry.destroy_entity(entity);
+            models.erase(entity);
+
+            entity = registry.create_entity();
+            models.emplace(entity, model{});
+
+            // [NOTE]: The new entity may recycle the id of the destroyed one, the stale handle must not touch it
+            auto thrown = false;
+
+            try {
+              registry.add_component<position>(stale, 0);
+            } catch (const std::invalid_argument&) {
+              thrown = true;
+            }
+
+            smoke::check(thrown && !registry.has_component<position>(entity));
+            break;
+          }
+        }
+
+        if (step % 10000 == 0) {
+          check_registry(registry, models);
+        }
+      }
+
+      check_registry(registry, models);
+    }
+
+    smoke::check(tracked::alive == 0);
+  });
+}
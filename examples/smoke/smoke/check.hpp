@@ -0,0 +1,48 @@
+#ifndef SMOKE_CHECK_HPP_
+#define SMOKE_CHECK_HPP_
+
+#include <cstdio>
+#include <exception>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+
+namespace smoke {
+
+/**
+ * @brief Throws when a condition does not hold, so a failing check ends the program with a non zero exit code even
+ * when assertions are disabled
+ *
+ * @param condition The condition to check
+ * @param location Location of the check, reported on failure
+ */
+inline auto check(const bool condition, const std::source_location location = std::source_location::current()) -> void {
+  if (!condition) {
+    throw std::runtime_error{std::string{location.file_name()} + ":" + std::to_string(location.line()) + ": check failed"};
+  }
+}
+
+/**
+ * @brief Runs the checks of a smoke program and turns their outcome into the exit code of the program
+ *
+ * @param name Name of the program, printed with the outcome
+ * @param func Function that runs the checks
+ *
+ * @return 0 when all checks passed, 1 otherwise
+ */
+template<typename Func>
+auto run(const char* name, Func func) -> int {
+  try {
+    func();
+  } catch (const std::exception& exception) {
+    std::fprintf(stderr, "%s: %s\n", name, exception.what());
+    return 1;
+  }
+
+  std::printf("%s: ok\n", name);
+  return 0;
+}
+
+} // namespace smoke
+
+#endif // SMOKE_CHECK_HPP_
@@ -0,0 +1,151 @@
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libecs/ecs.hpp>
+
+#include "check.hpp"
+
+inline constexpr auto thread_count = std::size_t{4};
+inline constexpr auto frame_count = 50;
+inline constexpr auto entities_per_frame = 200;
+
+// [NOTE]: Counts live instances, so a payload that the buffer leaks or destroys twice is detected
+struct tracked {
+  inline static auto alive = std::atomic<int>{0};
+
+  tracked(const int value)
+  : value{value} {
+    ++alive;
+  }
+
+  tracked(const tracked& other)
+  : value{other.value} {
+    ++alive;
+  }
+
+  tracked(tracked&& other) noexcept
+  : value{other.value} {
+    ++alive;
+  }
+
+  ~tracked() {
+    --alive;
+  }
+
+  auto operator=(const tracked&) -> tracked& = default;
+
+  auto operator=(tracked&&) noexcept -> tracked& = default;
+
+  int value;
+}; // struct tracked
+
+struct name {
+  std::string value;
+};
+
+struct marker { };
+
+auto record(ecs::command_buffer& buffer, const std::vector<ecs::entity>& existing, const std::size_t thread, const int frame) -> void {
+  for (auto index = 0; index < entities_per_frame; ++index) {
+    const auto value = frame * 1000 + index;
+    const auto entity = buffer.create_entity();
+
+    buffer.add_component<tracked>(entity, value);
+    buffer.add_component<name>(entity, std::string(64u, static_cast<char>('a' + thread)));
+
+    // [NOTE]: Components added and removed in the same buffer are applied in recording order
+    if (index % 4 == 0) {
+      buffer.add_component<marker>(entity);
+      buffer.remove_component<marker>(entity);
+    }
+
+    // [NOTE]: Entities created and destroyed in the same buffer never show up in the registry
+    if (index % 5 == 0) {
+      buffer.destroy_entity(entity);
+    }
+  }
+
+  for (auto index = thread; index < existing.size(); index += thread_count) {
+    buffer.add_component<marker>(existing[index]);
+  }
+}
+
+auto main() -> int {
+  return smoke::run("command_buffer", []() {
+    {
+      auto registry = ecs::registry{};
+      auto buffers = std::vector<ecs::command_buffer>(thread_count);
+      auto existing = std::vector<ecs::entity>{};
+      auto destroyed = std::size_t{0};
+
+      for (auto frame = 0; frame < frame_count; ++frame) {
+        auto threads = std::vector<std::thread>{};
+
+        for (auto thread = std::size_t{0}; thread < thread_count; ++thread) {
+          threads.emplace_back([&, thread]() { record(buffers[thread], existing, thread, frame); });
+        }
+
+        for (auto& thread : threads) {
+          thread.join();
+        }
+
+        // [NOTE]: Entities destroyed before the buffers are applied must not receive their recorded components
+        if (!existing.empty()) {
+          registry.destroy_entity(existing.front());
+          ++destroyed;
+        }
+
+        for (auto& buffer : buffers) {
+          buffer.apply(registry);
+          smoke::check(buffer.empty());
+        }
+
+        const auto created = static_cast<std::size_t>(entities_per_frame - entities_per_frame / 5);
+        auto count = std::size_t{0};
+
+        registry.create_view<const tracked, const name>().each([&](const tracked& t, const name& n) {
+          smoke::check(t.value / 1000 < frame + 1 && n.value.size() == 64u);
+          ++count;
+        });
+
+        smoke::check(count == created * thread_count * static_cast<std::size_t>(frame + 1) - destroyed);
+        smoke::check(static_cast<std::size_t>(tracked::alive.load()) == count);
+
+        for (auto index = std::size_t{1}; index < existing.size(); ++index) {
+          smoke::check(registry.has_all<marker>(existing[index]));
+        }
+
+        existing.clear();
+
+        registry.create_view<const tracked>().each([&](const ecs::entity entity, const tracked&) {
+          if (existing.size() < 100u && !registry.has_any<marker>(entity)) {
+            existing.push_back(entity);
+          }
+        });
+      }
+
+      // [NOTE]: Clearing a buffer destroys the components that were recorded but never applied
+      auto& buffer = buffers.front();
+      const auto alive = tracked::alive.load();
+
+      for (auto index = 0; index < 1000; ++index) {
+        buffer.add_component<tracked>(buffer.create_entity(), index);
+      }
+
+      smoke::check(tracked::alive.load() == alive + 1000);
+
+      buffer.clear();
+
+      smoke::check(buffer.empty() && tracked::alive.load() == alive);
+
+      for (auto index = 0; index < 1000; ++index) {
+        buffer.add_component<tracked>(buffer.create_entity(), index);
+      }
+    }
+
+    smoke::check(tracked::alive.load() == 0);
+  });
+}
@@ -0,0 +1,181 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <libecs/ecs.hpp>
+
+#include "check.hpp"
+
+struct position {
+  float value;
+};
+
+struct velocity {
+  float value;
+};
+
+auto check_order(ecs::executor& executor) -> void {
+  auto flow = ecs::task_flow{};
+  auto step = std::atomic<int>{0};
+  auto seen = std::vector<int>(4u, -1);
+
+  auto [a, b, c, d] = flow.emplace(
+    [&]() { seen[0] = step++; },
+    [&]() { seen[1] = step++; },
+    [&]() { seen[2] = step++; },
+    [&]() { seen[3] = step++; }
+  );
+
+  a.precede(b, c);
+  d.succeed(b, c);
+
+  executor.run_n(flow, 10u).get();
+
+  smoke::check(step.load() == 40);
+  smoke::check(seen[0] < seen[1] && seen[0] < seen[2] && seen[1] < seen[3] && seen[2] < seen[3]);
+}
+
+auto check_condition(ecs::executor& executor) -> void {
+  auto flow = ecs::task_flow{};
+  auto count = 0;
+
+  auto init = flow.emplace([&count]() { count = 0; });
+  auto body = flow.emplace([&count]() { ++count; });
+  auto loop = flow.emplace([&count]() { return count < 100 ? 0 : 1; });
+  auto stop = flow.placeholder();
+
+  init.precede(body);
+  body.precede(loop);
+  loop.precede(body, stop);
+
+  executor.run(flow).get();
+
+  smoke::check(count == 100);
+}
+
+// [NOTE]: Nested subflows join while other workers are joining too, which must neither deadlock nor lose tasks
+auto check_subflows(ecs::executor& executor) -> void {
+  auto flow = ecs::task_flow{};
+  auto leaves = std::atomic<int>{0};
+
+  for (auto index = 0; index < 16; ++index) {
+    flow.emplace([&leaves](ecs::subflow& outer) {
+      for (auto child = 0; child < 16; ++child) {
+        outer.emplace([&leaves](ecs::subflow& inner) {
+          for (auto leaf = 0; leaf < 4; ++leaf) {
+            inner.emplace([&leaves]() { leaves.fetch_add(1, std::memory_order_relaxed); });
+          }
+        });
+      }
+    });
+  }
+
+  executor.run_n(flow, 4u).get();
+
+  smoke::check(leaves.load() == 4 * 16 * 16 * 4);
+}
+
+auto check_exceptions(ecs::executor& executor) -> void {
+  auto flow = ecs::task_flow{};
+  auto successors = std::atomic<int>{0};
+
+  auto fail = flow.emplace([]() { throw std::logic_error{"task failed"}; });
+  auto next = flow.emplace([&successors]() { ++successors; });
+  auto last = flow.emplace([&successors]() { ++successors; });
+
+  fail.precede(next);
+  next.precede(last);
+
+  auto thrown = false;
+
+  try {
+    executor.run(flow).get();
+  } catch (const std::logic_error&) {
+    thrown = true;
+  }
+
+  smoke::check(thrown && successors.load() == 0);
+
+  thrown = false;
+
+  try {
+    executor.parallel_for(1000u, [](const std::size_t index) {
+      if (index == 500u) {
+        throw std::logic_error{"loop failed"};
+      }
+    });
+  } catch (const std::logic_error&) {
+    thrown = true;
+  }
+
+  smoke::check(thrown);
+}
+
+auto check_parallel_for(ecs::executor& executor) -> void {
+  auto hits = std::vector<std::atomic<int>>(10007u);
+
+  executor.parallel_for(3u, hits.size(), 64u, [&hits](const std::size_t index) {
+    hits[index].fetch_add(1, std::memory_order_relaxed);
+  });
+
+  for (auto index = std::size_t{0}; index < hits.size(); ++index) {
+    smoke::check(hits[index].load() == (index < 3u ? 0 : 1));
+  }
+
+  // [NOTE]: Loops started from tasks are joined by the worker that runs the task
+  auto flow = ecs::task_flow{};
+  auto sum = std::atomic<std::size_t>{0u};
+
+  for (auto task = 0; task < 8; ++task) {
+    flow.emplace([&executor, &sum]() {
+      executor.parallel_for(0u, 1000u, 7u, [&executor, &sum](const std::size_t outer) {
+        executor.parallel_for(10u, [&sum, outer](const std::size_t inner) {
+          sum.fetch_add(outer + inner, std::memory_order_relaxed);
+        });
+      });
+    });
+  }
+
+  executor.run(flow).get();
+
+  smoke::check(sum.load() == 8u * (10u * 999u * 1000u / 2u + 1000u * 45u));
+}
+
+auto check_par_each(ecs::executor& executor) -> void {
+  auto registry = ecs::registry{};
+  auto entities = std::vector<ecs::entity>(50000u);
+
+  registry.create_entities(entities.begin(), entities.size());
+  registry.insert<position>(entities.begin(), entities.end(), position{1.0f});
+  registry.insert<velocity>(entities.begin(), entities.end(), velocity{2.0f});
+
+  registry.create_view<position, const velocity>().par_each(executor, [](position& p, const velocity& v) {
+    p.value += v.value;
+  }, 512u);
+
+  auto pool = ecs::thread_pool{4u};
+
+  registry.create_view<position>().par_each(pool, [](position& p) {
+    p.value *= 2.0f;
+  }, 512u);
+
+  registry.create_view<const position>().each([](const position& p) {
+    smoke::check(p.value == 6.0f);
+  });
+}
+
+auto main() -> int {
+  return smoke::run("executor", []() {
+    for (const auto workers : {1u, 2u, 4u}) {
+      auto executor = ecs::executor{workers};
+
+      check_order(executor);
+      check_condition(executor);
+      check_subflows(executor);
+      check_exceptions(executor);
+      check_parallel_for(executor);
+      check_par_each(executor);
+    }
+  });
+}
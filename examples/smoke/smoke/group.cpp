@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <libecs/ecs.hpp>
+
+#include "check.hpp"
+
+struct position {
+  int value;
+};
+
+struct velocity {
+  int value;
+};
+
+struct frozen { };
+
+// [NOTE]: Every owned component carries the id of its entity, so a component that was swapped to the wrong position is detected
+auto check_group(ecs::registry& registry, const std::vector<ecs::entity>& entities) -> void {
+  auto group = registry.group<position, velocity>(ecs::get<>, ecs::exclude<frozen>);
+
+  const auto expected = std::ranges::count_if(entities, [&registry](const auto entity) {
+    return registry.is_valid_entity(entity) && registry.has_all<position, velocity>(entity) && !registry.has_any<frozen>(entity);
+  });
+
+  smoke::check(group.size() == static_cast<std::size_t>(expected));
+
+  auto visited = std::size_t{0};
+
+  for (auto [entity, p, v] : group.each()) {
+    const auto id = static_cast<int>(ecs::entity_traits<ecs::entity>::to_id(entity));
+    const auto index = static_cast<std::ptrdiff_t>(group.handle().index(entity));
+
+    smoke::check(p.value == id && v.value == id);
+    smoke::check(group.storage<position>().begin()[index].value == id && group.storage<velocity>().begin()[index].value == id);
+    smoke::check(group.contains(entity));
+
+    ++visited;
+  }
+
+  smoke::check(visited == group.size());
+}
+
+auto main() -> int {
+  return smoke::run("group", []() {
+    auto registry = ecs::registry{};
+    auto entities = std::vector<ecs::entity>(2000u);
+    auto random = std::minstd_rand{42u};
+
+    registry.create_entities(entities.begin(), entities.size());
+
+    for (const auto entity : entities) {
+      const auto id = static_cast<int>(ecs::entity_traits<ecs::entity>::to_id(entity));
+
+      registry.add_component<position>(entity, id);
+
+      if (id % 3 != 0) {
+        registry.add_component<velocity>(entity, id);
+      }
+    }
+
+    check_group(registry, entities);
+
+    for (auto step = 0; step < 20000; ++step) {
+      auto& entity = entities[random() % entities.size()];
+      const auto id = static_cast<int>(ecs::entity_traits<ecs::entity>::to_id(entity));
+
+      switch (random() % 7u) {
+        case 0u: registry.add_component<position>(entity, id); break;
+        case 1u: registry.add_component<velocity>(entity, id); break;
+        case 2u: registry.remove_component<position>(entity); break;
+        case 3u: registry.remove_component<velocity>(entity); break;
+        case 4u: registry.add_component<frozen>(entity); break;
+        case 5u: registry.remove_component<frozen>(entity); break;
+        default:
+          registry.destroy_entity(entity);
+          entity = registry.create_entity();
+          break;
+      }
+
+      if (step % 1000 == 0) {
+        check_group(registry, entities);
+      }
+    }
+
+    check_group(registry, entities);
+
+    // [NOTE]: Removing the current entity while iterating is allowed
+    auto group = registry.group<position, velocity>(ecs::get<>, ecs::exclude<frozen>);
+
+    for (auto [entity, p, v] : group.each()) {
+      registry.remove_component<velocity>(entity);
+    }
+
+    smoke::check(group.empty());
+    check_group(registry, entities);
+  });
+}
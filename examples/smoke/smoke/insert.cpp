@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <libecs/ecs.hpp>
+
+#include "check.hpp"
+
+struct position {
+  int value;
+};
+
+struct velocity {
+  int value;
+};
+
+struct paged {
+  int value;
+};
+
+template<>
+struct ecs::component_traits<paged> : ecs::basic_component_traits {
+  inline static constexpr auto page_size_v = std::size_t{64u};
+  inline static constexpr auto in_place_delete_v = true;
+}; // struct ecs::component_traits
+
+struct frozen { };
+
+inline auto constructed = std::size_t{0};
+
+// [NOTE]: Storages with in place deletion keep tombstones in their dense array, so only live keys are counted
+template<typename Component>
+auto count(ecs::registry& registry) -> std::size_t {
+  const auto& handle = registry.create_view<Component>().handle();
+  return static_cast<std::size_t>(std::ranges::count_if(handle, [&handle](const ecs::entity entity) { return !handle.is_tombstone(entity); }));
+}
+
+// [NOTE]: A rejected range must leave the storage, the signatures, groups and listeners exactly as they were
+template<typename Component>
+auto check_rejected(ecs::registry& registry, const std::vector<ecs::entity>& entities) -> void {
+  const auto size = count<Component>(registry);
+  const auto before = constructed;
+  auto thrown = false;
+
+  try {
+    registry.insert<Component>(entities.begin(), entities.end());
+  } catch (const std::invalid_argument&) {
+    thrown = true;
+  }
+
+  smoke::check(thrown && constructed == before);
+  smoke::check(count<Component>(registry) == size);
+
+  for (const auto entity : entities) {
+    smoke::check(registry.create_view<Component>().handle().contains(entity) == registry.has_all<Component>(entity));
+  }
+}
+
+template<typename Component>
+auto check_insert(ecs::registry& registry, const std::vector<ecs::entity>& entities) -> void {
+  const auto connection = registry.on_construct<Component>().connect([](ecs::registry&, const ecs::entity) { ++constructed; });
+
+  registry.insert<Component>(entities.begin(), entities.begin() + 100);
+  smoke::check(constructed == 100u);
+
+  // [NOTE]: The offending entity sits in the middle, so part of the range has been inserted when it is found
+  auto duplicate = std::vector<ecs::entity>(entities.begin() + 100, entities.begin() + 200);
+  duplicate.push_back(entities[150]);
+  duplicate.insert(duplicate.end(), entities.begin() + 200, entities.end());
+  check_rejected<Component>(registry, duplicate);
+
+  auto contained = std::vector<ecs::entity>(entities.begin() + 150, entities.end());
+  contained.push_back(entities[50]);
+  check_rejected<Component>(registry, contained);
+
+  const auto values = std::vector<Component>(200u);
+  auto thrown = false;
+
+  try {
+    registry.insert<Component>(duplicate.begin(), duplicate.begin() + 102, values.begin());
+  } catch (const std::invalid_argument&) {
+    thrown = true;
+  }
+
+  smoke::check(thrown && count<Component>(registry) == 100u);
+
+  registry.insert<Component>(entities.begin() + 100, entities.end());
+  smoke::check(constructed == 300u && count<Component>(registry) == 300u);
+
+  registry.on_construct<Component>().disconnect(connection);
+  constructed = 0u;
+}
+
+auto main() -> int {
+  return smoke::run("insert", []() {
+    auto registry = ecs::registry{};
+
+    // [NOTE]: The group owns position, so a second dense slot for an entity would break its packing
+    auto group = registry.group<position>(ecs::get<velocity>);
+    auto entities = std::vector<ecs::entity>(300u);
+
+    registry.create_entities(entities.begin(), entities.size());
+
+    check_insert<velocity>(registry, entities);
+    check_insert<position>(registry, entities);
+    check_insert<paged>(registry, entities);
+    check_insert<frozen>(registry, entities);
+
+    smoke::check(group.size() == 300u);
+  });
+}
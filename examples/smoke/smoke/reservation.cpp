@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <libecs/ecs.hpp>
+
+#include "check.hpp"
+
+inline constexpr auto thread_count = std::size_t{4};
+inline constexpr auto reservations_per_thread = std::size_t{10000};
+
+struct position {
+  int value;
+};
+
+auto main() -> int {
+  return smoke::run("reservation", []() {
+    auto registry = ecs::registry{};
+    auto existing = std::vector<ecs::entity>(1000u);
+
+    registry.create_entities(existing.begin(), existing.size());
+
+    // [NOTE]: Destroyed ids are not recycled by reservations, so reserved entities never alias destroyed ones
+    registry.destroy_entities(existing.begin(), existing.begin() + 500);
+
+    auto reserved = std::vector<std::vector<ecs::entity>>(thread_count);
+    auto threads = std::vector<std::thread>{};
+
+    for (auto thread = std::size_t{0}; thread < thread_count; ++thread) {
+      threads.emplace_back([&registry, &reserved, thread]() {
+        for (auto index = std::size_t{0}; index < reservations_per_thread; ++index) {
+          reserved[thread].push_back(registry.reserve_entity());
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    auto all = std::vector<ecs::entity>{};
+
+    for (const auto& entities : reserved) {
+      all.insert(all.end(), entities.begin(), entities.end());
+    }
+
+    std::ranges::sort(all);
+    smoke::check(std::ranges::adjacent_find(all) == all.end());
+
+    for (const auto entity : all) {
+      smoke::check(!registry.is_valid_entity(entity));
+    }
+
+    auto thrown = false;
+
+    try {
+      registry.add_component<position>(all.front(), 0);
+    } catch (const std::invalid_argument&) {
+      thrown = true;
+    }
+
+    smoke::check(thrown);
+
+    // [NOTE]: Other member functions treat reserved entities like destroyed ones
+    registry.remove_component<position>(all.front());
+    registry.destroy_entity(all.back());
+    smoke::check(!registry.has_any<position>(all.front()));
+
+    registry.flush();
+
+    for (const auto entity : all) {
+      smoke::check(registry.is_valid_entity(entity) && !registry.has_any<position>(entity));
+      registry.add_component<position>(entity, static_cast<int>(ecs::entity_traits<ecs::entity>::to_id(entity)));
+    }
+
+    for (auto index = std::size_t{500}; index < existing.size(); ++index) {
+      smoke::check(registry.is_valid_entity(existing[index]));
+    }
+
+    // [NOTE]: Creating entities flushes pending reservations before recycling ids
+    const auto pending = registry.reserve_entity();
+    const auto created = registry.create_entity();
+
+    smoke::check(registry.is_valid_entity(pending) && registry.is_valid_entity(created) && pending != created);
+
+    auto count = std::size_t{0};
+
+    registry.create_view<const position>().each([&count](const ecs::entity entity, const position& p) {
+      smoke::check(p.value == static_cast<int>(ecs::entity_traits<ecs::entity>::to_id(entity)));
+      ++count;
+    });
+
+    smoke::check(count == all.size());
+  });
+}
@@ -0,0 +1,138 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <libecs/ecs.hpp>
+
+#include "check.hpp"
+
+struct body {
+  float x;
+  float y;
+  int id;
+};
+
+template<>
+struct ecs::component_traits<body> : ecs::basic_component_traits {
+  using fields_type = ecs::fields_t<&body::x, &body::y, &body::id>;
+}; // struct ecs::component_traits
+
+struct tag {
+  int id;
+};
+
+auto id_of(const ecs::entity entity) -> int {
+  return static_cast<int>(ecs::entity_traits<ecs::entity>::to_id(entity));
+}
+
+// [NOTE]: Every member of a body is derived from its entity, so a field array that was not swapped or moved together with the others is detected
+auto check_fields(ecs::registry& registry) -> void {
+  auto group = registry.group<body, tag>();
+
+  const auto xs = group.field<&body::x>();
+  const auto ys = group.field<&body::y>();
+  const auto ids = group.field<&body::id>();
+
+  smoke::check(xs.size() == group.size() && ys.size() == group.size() && ids.size() == group.size());
+
+  auto index = std::size_t{0};
+
+  for (const auto entity : group.handle()) {
+    if (index == group.size()) {
+      break;
+    }
+
+    const auto id = id_of(entity);
+
+    smoke::check(ids[index] == id && xs[index] == static_cast<float>(id) && ys[index] == static_cast<float>(2 * id));
+    smoke::check(registry.get_component<tag>(entity)->id == id);
+    ++index;
+  }
+
+  auto visited = std::size_t{0};
+
+  registry.create_view<body>().each([&visited](const ecs::entity entity, ecs::soa_reference<body> b) {
+    const auto value = static_cast<body>(b);
+
+    smoke::check(value.id == id_of(entity) && value.x == static_cast<float>(value.id) && value.y == static_cast<float>(2 * value.id));
+    ++visited;
+  });
+
+  smoke::check(visited == registry.create_view<body>().storage().size());
+  smoke::check(registry.create_view<body>().field<&body::id>().size() == visited);
+}
+
+auto main() -> int {
+  return smoke::run("soa", []() {
+    auto registry = ecs::registry{};
+    auto entities = std::vector<ecs::entity>(3000u);
+    auto random = std::minstd_rand{11u};
+
+    registry.create_entities(entities.begin(), entities.size());
+
+    // [NOTE]: The group owns the structure of arrays, so every add and remove swaps all of its field arrays
+    static_cast<void>(registry.group<body, tag>());
+
+    auto add_body = [&registry](const ecs::entity entity) {
+      const auto id = id_of(entity);
+      registry.add_component<body>(entity, static_cast<float>(id), 0.0f, id);
+
+      // [NOTE]: Single members are written through the proxy, whole components through assignment and patch
+      registry.get_component<body>(entity)->get<&body::y>() = static_cast<float>(2 * id);
+    };
+
+    for (const auto entity : entities) {
+      add_body(entity);
+
+      if (id_of(entity) % 2 == 0) {
+        registry.add_component<tag>(entity, id_of(entity));
+      }
+    }
+
+    check_fields(registry);
+
+    for (auto step = 0; step < 30000; ++step) {
+      auto& entity = entities[random() % entities.size()];
+      const auto id = id_of(entity);
+
+      switch (random() % 6u) {
+        case 0u: add_body(entity); break;
+        case 1u: registry.add_component<tag>(entity, id); break;
+        case 2u: registry.remove_component<body>(entity); break;
+        case 3u: registry.remove_component<tag>(entity); break;
+        case 4u:
+          if (registry.has_all<body>(entity)) {
+            *registry.get_component<body>(entity) = body{static_cast<float>(id), static_cast<float>(2 * id), id};
+            registry.patch<body>(entity, [id](ecs::soa_reference<body> b) { b.get<&body::x>() = static_cast<float>(id); });
+          }
+          break;
+        default:
+          registry.destroy_entity(entity);
+          entity = registry.create_entity();
+          break;
+      }
+
+      if (step % 3000 == 0) {
+        check_fields(registry);
+      }
+    }
+
+    check_fields(registry);
+
+    // [NOTE]: Field arrays stay contiguous, so loops over a single member can write them directly
+    auto group = registry.group<body, tag>();
+    const auto xs = group.field<&body::x>();
+    const auto ids = group.field<&body::id>();
+
+    for (auto index = std::size_t{0}; index < xs.size(); ++index) {
+      xs[index] = static_cast<float>(ids[index]);
+    }
+
+    registry.create_view<body>().each([](ecs::soa_reference<body> b) {
+      const auto copy = body{b.get<&body::x>(), b.get<&body::y>(), b.get<&body::id>()};
+      b = copy;
+    });
+
+    check_fields(registry);
+  });
+}
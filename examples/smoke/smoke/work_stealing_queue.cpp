@@ -0,0 +1,63 @@
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <libecs/work_stealing_queue.hpp>
+
+#include "check.hpp"
+
+inline constexpr auto value_count = std::size_t{200000};
+inline constexpr auto thief_count = std::size_t{3};
+
+auto main() -> int {
+  return smoke::run("work_stealing_queue", []() {
+    // [NOTE]: A small initial capacity makes the owner grow the buffer while thieves read from it
+    auto queue = ecs::work_stealing_queue<std::size_t>{2u};
+    auto taken = std::vector<std::atomic<int>>(value_count);
+    auto done = std::atomic<bool>{false};
+
+    auto take = [&taken](const std::size_t value) {
+      taken[value].fetch_add(1, std::memory_order_relaxed);
+    };
+
+    auto thieves = std::vector<std::thread>{};
+
+    for (auto index = std::size_t{0}; index < thief_count; ++index) {
+      thieves.emplace_back([&]() {
+        while (!done.load(std::memory_order_acquire) || !queue.empty()) {
+          if (const auto value = queue.steal(); value) {
+            take(*value);
+          }
+        }
+      });
+    }
+
+    for (auto value = std::size_t{0}; value < value_count; ++value) {
+      queue.push(value);
+
+      // [NOTE]: The owner pops some of its own values, so it races with the thieves for the last element
+      if (value % 3u == 0u) {
+        if (const auto popped = queue.pop(); popped) {
+          take(*popped);
+        }
+      }
+    }
+
+    while (const auto value = queue.pop()) {
+      take(*value);
+    }
+
+    done.store(true, std::memory_order_release);
+
+    for (auto& thief : thieves) {
+      thief.join();
+    }
+
+    for (const auto& count : taken) {
+      smoke::check(count.load() == 1);
+    }
+
+    smoke::check(queue.empty() && queue.size() == 0u);
+  });
+}
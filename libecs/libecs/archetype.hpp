@@ -0,0 +1,894 @@
+#ifndef LIBECS_ARCHETYPE_HPP_
+#define LIBECS_ARCHETYPE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libecs/memory.hpp>
+#include <libecs/entity.hpp>
+#include <libecs/type_list.hpp>
+#include <libecs/type_index.hpp>
+#include <libecs/component_handle.hpp>
+#include <libecs/view.hpp>
+#include <libecs/registry.hpp>
+
+namespace ecs {
+
+namespace detail {
+
+/**
+ * @brief Type erased operations on the components of one type, used to move them between archetypes
+ */
+struct component_info {
+  std::size_t type;
+  std::size_t size;
+  std::size_t alignment;
+  auto (*relocate)(std::byte* destination, std::byte* source) noexcept -> void;
+  auto (*destroy)(std::byte* value) noexcept -> void;
+}; // struct component_info
+
+template<typename Type>
+auto component_info_of() noexcept -> const component_info* {
+  static_assert(std::is_nothrow_move_constructible_v<Type>, "Components of archetypes must be nothrow move constructible");
+  static_assert(alignof(Type) <= cache_line_size_v, "Component alignment exceeds the alignment of archetype chunks");
+
+  // [NOTE]: Empty types take no space in the chunks, since all of their values are interchangeable
+  static const auto info = component_info{
+    type_id<Type>(),
+    std::is_empty_v<Type> ? 0u : sizeof(Type),
+    alignof(Type),
+    [](std::byte* destination, std::byte* source) noexcept -> void {
+      if constexpr (!std::is_empty_v<Type>) {
+        auto* value = std::launder(reinterpret_cast<Type*>(source));
+        std::construct_at(reinterpret_cast<Type*>(destination), std::move(*value));
+        std::destroy_at(value);
+      }
+    },
+    [](std::byte* value) noexcept -> void {
+      if constexpr (!std::is_empty_v<Type>) {
+        std::destroy_at(std::launder(reinterpret_cast<Type*>(value)));
+      }
+    }
+  };
+
+  return &info;
+}
+
+/**
+ * @brief Stores the entities that have exactly the same component types. Rows are packed into fixed size chunks, each
+ * chunk holds one array of entities followed by one array per component type
+ *
+ * @note Rows are kept dense, removing a row moves the last one into its place
+ *
+ * @tparam Entity Type of the entities
+ */
+template<typename Entity>
+class archetype {
+
+public:
+
+  using entity_type = Entity;
+  using size_type = std::size_t;
+
+  inline static constexpr auto chunk_size_v = std::size_t{16384u};
+  inline static constexpr auto npos_v = std::numeric_limits<size_type>::max();
+
+private:
+
+  struct alignas(cache_line_size_v) chunk {
+    std::array<std::byte, chunk_size_v> data;
+  }; // struct chunk
+
+public:
+
+  /**
+   * @brief Constructs an empty archetype
+   *
+   * @param components Component types of the archetype
+   *
+   * @throws std::length_error when a single row of the component types does not fit into a chunk
+   */
+  explicit archetype(std::vector<const component_info*> components)
+  : _components{std::move(components)},
+    _offsets{},
+    _columns{},
+    _capacity{0u},
+    _size{0u},
+    _chunks{},
+    _add_edges{},
+    _remove_edges{} {
+    std::ranges::sort(_components, [](const auto* lhs, const auto* rhs) { return lhs->type < rhs->type; });
+
+    _layout();
+
+    for (auto column = size_type{0}; column < _components.size(); ++column) {
+      const auto type = _components[column]->type;
+
+      if (type >= _columns.size()) {
+        _columns.resize(type + 1u, npos_v);
+      }
+
+      _columns[type] = column;
+    }
+  }
+
+  archetype(const archetype&) = delete;
+
+  archetype(archetype&&) = delete;
+
+  ~archetype() {
+    clear();
+  }
+
+  auto operator=(const archetype&) -> archetype& = delete;
+
+  auto operator=(archetype&&) -> archetype& = delete;
+
+  /**
+   * @brief Gets the component types of the archetype, sorted by type id
+   *
+   * @return
+   */
+  auto components() const noexcept -> const std::vector<const component_info*>& {
+    return _components;
+  }
+
+  auto size() const noexcept -> size_type {
+    return _size;
+  }
+
+  /**
+   * @brief Gets the number of rows that fit into a chunk
+   *
+   * @return
+   */
+  auto capacity() const noexcept -> size_type {
+    return _capacity;
+  }
+
+  /**
+   * @brief Gets the number of chunks that hold at least one row
+   *
+   * @return
+   */
+  auto chunks() const noexcept -> size_type {
+    return (_size + _capacity - 1u) / _capacity;
+  }
+
+  auto rows(const size_type chunk) const noexcept -> size_type {
+    return std::min(_capacity, _size - chunk * _capacity);
+  }
+
+  auto contains(const size_type type) const noexcept -> bool {
+    return type < _columns.size() && _columns[type] != npos_v;
+  }
+
+  /**
+   * @brief Gets the column of a component type
+   *
+   * @param type Type id of the component
+   *
+   * @return The index of the column or npos_v if the archetype does not have the component type
+   */
+  auto column(const size_type type) const noexcept -> size_type {
+    return contains(type) ? _columns[type] : npos_v;
+  }
+
+  auto entities(const size_type chunk) const noexcept -> entity_type* {
+    return reinterpret_cast<entity_type*>(_chunks[chunk]->data.data());
+  }
+
+  auto data(const size_type column, const size_type chunk) const noexcept -> std::byte* {
+    return _chunks[chunk]->data.data() + _offsets[column];
+  }
+
+  auto entity_at(const size_type row) const noexcept -> entity_type& {
+    return entities(row / _capacity)[row % _capacity];
+  }
+
+  auto at(const size_type column, const size_type row) const noexcept -> std::byte* {
+    return data(column, row / _capacity) + _components[column]->size * (row % _capacity);
+  }
+
+  /**
+   * @brief Appends a row. Its components are not constructed
+   *
+   * @param entity The entity of the row
+   *
+   * @return The index of the row
+   */
+  auto push(const entity_type& entity) -> size_type {
+    if (_size == _chunks.size() * _capacity) {
+      _chunks.push_back(std::make_unique<chunk>());
+    }
+
+    entity_at(_size) = entity;
+
+    return _size++;
+  }
+
+  /**
+   * @brief Removes the last row. Its components must not be constructed
+   */
+  auto pop() noexcept -> void {
+    --_size;
+  }
+
+  /**
+   * @brief Moves the last row into a row whose components have already been moved out or destroyed
+   *
+   * @param row The index of the row
+   *
+   * @return The entity that has been moved into the row or null_entity if the row was the last one
+   */
+  auto fill(const size_type row) noexcept -> entity_type {
+    const auto last = --_size;
+
+    if (row == last) {
+      return null_entity;
+    }
+
+    for (auto column = size_type{0}; column < _components.size(); ++column) {
+      _components[column]->relocate(at(column, row), at(column, last));
+    }
+
+    return entity_at(row) = entity_at(last);
+  }
+
+  /**
+   * @brief Destroys the components of a row and moves the last row into its place
+   *
+   * @param row The index of the row
+   *
+   * @return The entity that has been moved into the row or null_entity if the row was the last one
+   */
+  auto erase(const size_type row) noexcept -> entity_type {
+    for (auto column = size_type{0}; column < _components.size(); ++column) {
+      _components[column]->destroy(at(column, row));
+    }
+
+    return fill(row);
+  }
+
+  /**
+   * @brief Destroys all rows. The chunks are kept for reuse
+   */
+  auto clear() noexcept -> void {
+    for (auto row = size_type{0}; row < _size; ++row) {
+      for (auto column = size_type{0}; column < _components.size(); ++column) {
+        _components[column]->destroy(at(column, row));
+      }
+    }
+
+    _size = 0u;
+  }
+
+  /**
+   * @brief Gets the archetype that has the component types of this one and one more or one less
+   *
+   * @param type Type id of the added or removed component
+   *
+   * @return The index of the archetype in the registry or npos_v if it has not been looked up yet
+   */
+  auto add_edge(const size_type type) const noexcept -> size_type {
+    return type < _add_edges.size() ? _add_edges[type] : npos_v;
+  }
+
+  auto remove_edge(const size_type type) const noexcept -> size_type {
+    return type < _remove_edges.size() ? _remove_edges[type] : npos_v;
+  }
+
+  auto set_add_edge(const size_type type, const size_type target) -> void {
+    _set_edge(_add_edges, type, target);
+  }
+
+  auto set_remove_edge(const size_type type, const size_type target) -> void {
+    _set_edge(_remove_edges, type, target);
+  }
+
+private:
+
+  static auto _set_edge(std::vector<size_type>& edges, const size_type type, const size_type target) -> void {
+    if (type >= edges.size()) {
+      edges.resize(type + 1u, npos_v);
+    }
+
+    edges[type] = target;
+  }
+
+  // [NOTE]: Starts from the capacity without padding and shrinks it until the aligned columns fit into a chunk
+  auto _layout() -> void {
+    auto row_size = sizeof(entity_type);
+
+    for (const auto* component : _components) {
+      row_size += component->size;
+    }
+
+    for (_capacity = chunk_size_v / row_size; _capacity != 0u; --_capacity) {
+      auto offset = sizeof(entity_type) * _capacity;
+
+      _offsets.clear();
+
+      for (const auto* component : _components) {
+        offset = (offset + component->alignment - 1u) / component->alignment * component->alignment;
+        _offsets.push_back(offset);
+        offset += component->size * _capacity;
+      }
+
+      if (offset <= chunk_size_v) {
+        return;
+      }
+    }
+
+    throw std::length_error{"Components do not fit into an archetype chunk"};
+  }
+
+  std::vector<const component_info*> _components;
+  std::vector<size_type> _offsets;
+  std::vector<size_type> _columns;
+
+  size_type _capacity;
+  size_type _size;
+  std::vector<std::unique_ptr<chunk>> _chunks;
+
+  std::vector<size_type> _add_edges;
+  std::vector<size_type> _remove_edges;
+
+}; // class archetype
+
+} // namespace detail
+
+template<typename, typename, typename>
+class basic_archetype_view;
+
+/**
+ * @brief View over the entities of an archetype registry that have all of the required components and none of the
+ * excluded ones. Archetypes are matched instead of entities, the rows of a matching archetype are walked chunk by chunk
+ *
+ * @note Adding or removing components, or creating or destroying entities, while iterating the view invalidates the
+ * iteration
+ *
+ * @tparam Entity Type of the entities
+ * @tparam Components Types of the required components
+ * @tparam Exclude Types of the excluded components
+ */
+template<typename Entity, typename... Components, typename... Exclude>
+class basic_archetype_view<Entity, get_t<Components...>, exclude_t<Exclude...>> {
+
+  using archetype_type = detail::archetype<Entity>;
+  using archetype_storage_type = std::vector<std::unique_ptr<archetype_type>>;
+
+  template<typename Type, allocator_for<Type> Allocator>
+  friend class basic_archetype_registry;
+
+public:
+
+  using entity_type = Entity;
+  using size_type = std::size_t;
+
+  basic_archetype_view() noexcept
+  : _archetypes{nullptr} { }
+
+  /**
+   * @brief Gets the number of entities in the view
+   *
+   * @return
+   */
+  auto size() const noexcept -> size_type {
+    auto size = size_type{0};
+
+    _for_each_archetype([&size](const archetype_type& archetype) { size += archetype.size(); });
+
+    return size;
+  }
+
+  auto empty() const noexcept -> bool {
+    return size() == 0u;
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view. The function takes the entity followed by the components,
+   * or the components alone. Empty components are not passed
+   *
+   * @note Within a chunk the components are read from contiguous arrays, one per component type
+   *
+   * @param func The function to invoke
+   */
+  template<typename Func>
+  auto each(Func func) const -> void {
+    _for_each_archetype([&func](const archetype_type& archetype) {
+      const auto columns = std::array<size_type, sizeof...(Components)>{archetype.column(type_id<Components>())...};
+
+      for (auto chunk = size_type{0}; chunk < archetype.chunks(); ++chunk) {
+        _each(func, archetype, chunk, columns, std::index_sequence_for<Components...>{});
+      }
+    });
+  }
+
+private:
+
+  explicit basic_archetype_view(const archetype_storage_type& archetypes) noexcept
+  : _archetypes{&archetypes} { }
+
+  template<typename Func>
+  auto _for_each_archetype(Func func) const -> void {
+    if (!_archetypes) {
+      return;
+    }
+
+    for (const auto& archetype : *_archetypes) {
+      if (archetype->size() != 0u && (archetype->contains(type_id<Components>()) && ...) && (!archetype->contains(type_id<Exclude>()) && ...)) {
+        func(*archetype);
+      }
+    }
+  }
+
+  template<typename Type>
+  static auto _column(const archetype_type& archetype, const size_type column, const size_type chunk) noexcept -> Type* {
+    if constexpr (std::is_empty_v<Type>) {
+      return nullptr;
+    } else {
+      return std::launder(reinterpret_cast<Type*>(archetype.data(column, chunk)));
+    }
+  }
+
+  template<typename Type>
+  static auto _fetch([[maybe_unused]] Type* column, [[maybe_unused]] const size_type row) noexcept {
+    if constexpr (std::is_empty_v<Type>) {
+      return std::tuple<>{};
+    } else {
+      return std::forward_as_tuple(column[row]);
+    }
+  }
+
+  template<typename Func, std::size_t... Index>
+  static auto _each(Func& func, const archetype_type& archetype, const size_type chunk, const std::array<size_type, sizeof...(Components)>& columns, std::index_sequence<Index...>) -> void {
+    const auto* entities = archetype.entities(chunk);
+    const auto rows = archetype.rows(chunk);
+
+    [[maybe_unused]] const auto data = std::make_tuple(_column<Components>(archetype, columns[Index], chunk)...);
+
+    for (auto row = size_type{0}; row < rows; ++row) {
+      detail::invoke_each(func, entities[row], std::tuple_cat(_fetch<Components>(std::get<Index>(data), row)...));
+    }
+  }
+
+  const archetype_storage_type* _archetypes;
+
+}; // class basic_archetype_view
+
+/**
+ * @brief Registry that keeps the entities with the same component types together in archetypes. Adding or removing a
+ * component moves the components of the entity to another archetype, views walk the matching archetypes
+ *
+ * @note Suits iteration heavy workloads with many components per entity. Components must be nothrow move
+ * constructible, since they are moved whenever the component types of their entity change. References to components
+ * are invalidated by adding or removing components of any entity of the same archetype
+ *
+ * @tparam Entity Type of the entities
+ * @tparam Allocator Allocator type of the entities
+ */
+template<typename Entity, allocator_for<Entity> Allocator = std::allocator<Entity>>
+class basic_archetype_registry {
+
+  using entity_traits = ecs::entity_traits<Entity>;
+
+  using entity_storage_type = std::vector<Entity, Allocator>;
+
+  using archetype_type = detail::archetype<Entity>;
+
+  struct location {
+    std::size_t archetype;
+    std::size_t row;
+  }; // struct location
+
+  inline static constexpr auto npos_v = archetype_type::npos_v;
+
+public:
+
+  using entity_type = entity_traits::entity_type;
+  using version_type = entity_traits::version_type;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+  basic_archetype_registry() = default;
+
+  basic_archetype_registry(const basic_archetype_registry&) = delete;
+
+  basic_archetype_registry(basic_archetype_registry&& other) noexcept
+  : _entities{std::move(other._entities)},
+    _locations{std::move(other._locations)},
+    _free_list{std::exchange(other._free_list, null_entity)},
+    _archetypes{std::exchange(other._archetypes, {})} { }
+
+  ~basic_archetype_registry() = default;
+
+  auto operator=(const basic_archetype_registry&) -> basic_archetype_registry& = delete;
+
+  auto operator=(basic_archetype_registry&& other) noexcept -> basic_archetype_registry& {
+    if (this != &other) {
+      _entities = std::move(other._entities);
+      _locations = std::move(other._locations);
+      _free_list = std::exchange(other._free_list, null_entity);
+      _archetypes = std::exchange(other._archetypes, {});
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Gets the number of archetypes, including the one of the entities without components
+   *
+   * @return
+   */
+  auto archetypes() const noexcept -> size_type {
+    return _archetypes.size();
+  }
+
+  auto clear() -> void {
+    for (auto& archetype : _archetypes) {
+      archetype->clear();
+    }
+
+    _entities.clear();
+    _locations.clear();
+    _free_list = null_entity;
+  }
+
+  auto create_entity() -> entity_type {
+    auto entity = entity_type{null_entity};
+
+    // [NOTE]: The free list is threaded through the destroyed slots, like in basic_registry
+    if (_free_list != null_entity) {
+      const auto id = entity_traits::to_id(_free_list);
+      auto& slot = _entities[static_cast<size_type>(id)];
+
+      _free_list = entity_traits::construct(entity_traits::to_id(slot), entity_traits::to_version(null_entity));
+      slot = entity_traits::construct(id, entity_traits::to_version(slot));
+      entity = slot;
+    } else {
+      entity = entity_traits::construct(static_cast<entity_traits::id_type>(_entities.size()));
+      _entities.push_back(entity);
+      _locations.push_back(location{npos_v, npos_v});
+    }
+
+    auto& root = _root();
+    _locations[static_cast<size_type>(entity_traits::to_id(entity))] = location{0u, root.push(entity)};
+
+    return entity;
+  }
+
+  auto destroy_entity(const entity_type& entity) -> void {
+    if (!is_valid_entity(entity)) {
+      return;
+    }
+
+    const auto index = static_cast<size_type>(entity_traits::to_id(entity));
+    const auto [archetype, row] = _locations[index];
+
+    _relocated(_archetypes[archetype]->erase(row), row);
+
+    _entities[index] = entity_traits::construct(entity_traits::to_id(_free_list), entity_traits::to_version(entity_traits::next(entity)));
+    _free_list = entity_traits::construct(entity_traits::to_id(entity), entity_traits::to_version(null_entity));
+  }
+
+  auto is_valid_entity(const entity_type& entity) const -> bool {
+    const auto index = static_cast<size_type>(entity_traits::to_id(entity));
+    return index < _entities.size() && entity == _entities[index];
+  }
+
+  template<typename Component>
+  auto has_component(const entity_type& entity) const -> bool {
+    return is_valid_entity(entity) && _archetype_of(entity).contains(type_id<Component>());
+  }
+
+  /**
+   * @brief Assigns a component to an entity. A component that is already assigned is replaced in place, otherwise the
+   * components of the entity are moved to the archetype that also has the new type
+   *
+   * @tparam Component Type of the component
+   *
+   * @param entity The entity to assign the component to
+   * @param args Arguments to construct the component with
+   *
+   * @throws std::invalid_argument when the entity is not valid
+   *
+   * @return The component
+   */
+  template<typename Component, typename... Args>
+  auto add_component(const entity_type& entity, Args&&... args) -> component_handle<Component> {
+    using value_type = std::remove_const_t<Component>;
+
+    // [NOTE]: A stale entity shares its location with the entity that recycled it, so it must not be moved
+    if (!is_valid_entity(entity)) {
+      throw std::invalid_argument{"Entity is not valid"};
+    }
+
+    const auto* info = detail::component_info_of<value_type>();
+    const auto index = static_cast<size_type>(entity_traits::to_id(entity));
+    const auto [source_index, source_row] = _locations[index];
+
+    auto& source = *_archetypes[source_index];
+
+    if (const auto column = source.column(info->type); column != npos_v) {
+      if constexpr (std::is_empty_v<value_type>) {
+        return _instance<value_type>();
+      } else {
+        auto& value = *std::launder(reinterpret_cast<value_type*>(source.at(column, source_row)));
+        value = value_type{std::forward<Args>(args)...};
+        return value;
+      }
+    }
+
+    const auto target_index = _target(source_index, info, true);
+    auto& target = *_archetypes[target_index];
+    const auto target_row = target.push(entity);
+
+    // [NOTE]: The new component is constructed first, so nothing has been moved yet if its constructor throws
+    auto* value = static_cast<value_type*>(nullptr);
+
+    if constexpr (!std::is_empty_v<value_type>) {
+      try {
+        value = std::construct_at(reinterpret_cast<value_type*>(target.at(target.column(info->type), target_row)), std::forward<Args>(args)...);
+      } catch (...) {
+        target.pop();
+        throw;
+      }
+    }
+
+    _move_row(source, source_row, target, target_row);
+    _locations[index] = location{target_index, target_row};
+
+    if constexpr (std::is_empty_v<value_type>) {
+      return _instance<value_type>();
+    } else {
+      return *value;
+    }
+  }
+
+  template<typename Component>
+  auto remove_component(const entity_type& entity) -> void {
+    if (!has_component<Component>(entity)) {
+      return;
+    }
+
+    const auto* info = detail::component_info_of<std::remove_const_t<Component>>();
+    const auto index = static_cast<size_type>(entity_traits::to_id(entity));
+    const auto [source_index, source_row] = _locations[index];
+
+    const auto target_index = _target(source_index, info, false);
+    auto& target = *_archetypes[target_index];
+    const auto target_row = target.push(entity);
+
+    _move_row(*_archetypes[source_index], source_row, target, target_row);
+    _locations[index] = location{target_index, target_row};
+  }
+
+  template<typename Component>
+  auto try_get_component(const entity_type& entity) const -> component_handle<const Component> {
+    return _try_get<const std::remove_const_t<Component>>(entity);
+  }
+
+  template<typename Component>
+  auto try_get_component(const entity_type& entity) -> component_handle<Component> {
+    return _try_get<Component>(entity);
+  }
+
+  /**
+   * @brief Gets the component assigned to an entity
+   *
+   * @throws std::runtime_error when the entity does not have a component of the given type assigned to itself
+   *
+   * @return The component assigned to the entity
+   */
+  template<typename Component>
+  auto get_component(const entity_type& entity) const -> component_handle<const Component> {
+    if (const auto component = try_get_component<Component>(entity); component) {
+      return component;
+    }
+
+    throw std::runtime_error{"Entity does not have component assigned to it"};
+  }
+
+  template<typename Component>
+  auto get_component(const entity_type& entity) -> component_handle<Component> {
+    if (auto component = try_get_component<Component>(entity); component) {
+      return component;
+    }
+
+    throw std::runtime_error{"Entity does not have component assigned to it"};
+  }
+
+  /**
+   * @brief Creates a view over the entities that have all of the given components and none of the excluded ones
+   *
+   * @tparam Components Types of the required components
+   * @tparam Exclude Types of the components that must not be assigned
+   *
+   * @return The view
+   */
+  template<typename... Components, typename... Exclude>
+  requires (variadic_template_size_v<Components...> != 0)
+  auto create_view(exclude_t<Exclude...> = exclude_t<Exclude...>{}) -> basic_archetype_view<Entity, get_t<Components...>, exclude_t<Exclude...>> {
+    return basic_archetype_view<Entity, get_t<Components...>, exclude_t<Exclude...>>{_archetypes};
+  }
+
+private:
+
+  template<typename Type>
+  static auto _instance() noexcept -> Type& {
+    static auto instance = std::remove_const_t<Type>{};
+    return instance;
+  }
+
+  auto _root() -> archetype_type& {
+    if (_archetypes.empty()) {
+      _archetypes.push_back(std::make_unique<archetype_type>(std::vector<const detail::component_info*>{}));
+    }
+
+    return *_archetypes.front();
+  }
+
+  auto _archetype_of(const entity_type& entity) const noexcept -> const archetype_type& {
+    return *_archetypes[_locations[static_cast<size_type>(entity_traits::to_id(entity))].archetype];
+  }
+
+  template<typename Component>
+  auto _try_get(const entity_type& entity) const -> component_handle<Component> {
+    if (!is_valid_entity(entity)) {
+      return component_handle<Component>{};
+    }
+
+    const auto [archetype, row] = _locations[static_cast<size_type>(entity_traits::to_id(entity))];
+
+    if (const auto column = _archetypes[archetype]->column(type_id<Component>()); column != npos_v) {
+      if constexpr (std::is_empty_v<Component>) {
+        return _instance<Component>();
+      } else {
+        return *std::launder(reinterpret_cast<Component*>(_archetypes[archetype]->at(column, row)));
+      }
+    }
+
+    return component_handle<Component>{};
+  }
+
+  auto _relocated(const entity_type& moved, const size_type row) -> void {
+    if (moved != null_entity) {
+      _locations[static_cast<size_type>(entity_traits::to_id(moved))].row = row;
+    }
+  }
+
+  // [NOTE]: Components the target has are moved over, the others are destroyed. The hole is then filled with the last row of the source
+  auto _move_row(archetype_type& source, const size_type source_row, archetype_type& target, const size_type target_row) -> void {
+    const auto& components = source.components();
+
+    for (auto column = size_type{0}; column < components.size(); ++column) {
+      if (const auto target_column = target.column(components[column]->type); target_column != npos_v) {
+        components[column]->relocate(target.at(target_column, target_row), source.at(column, source_row));
+      } else {
+        components[column]->destroy(source.at(column, source_row));
+      }
+    }
+
+    _relocated(source.fill(source_row), source_row);
+  }
+
+  // [NOTE]: Transitions are cached on both archetypes, so each one is only looked up once
+  auto _target(const size_type source_index, const detail::component_info* info, const bool add) -> size_type {
+    if (const auto edge = add ? _archetypes[source_index]->add_edge(info->type) : _archetypes[source_index]->remove_edge(info->type); edge != npos_v) {
+      return edge;
+    }
+
+    auto components = _archetypes[source_index]->components();
+
+    if (add) {
+      components.push_back(info);
+    } else {
+      std::erase(components, info);
+    }
+
+    std::ranges::sort(components, [](const auto* lhs, const auto* rhs) { return lhs->type < rhs->type; });
+
+    auto target_index = static_cast<size_type>(std::distance(_archetypes.begin(), std::ranges::find_if(_archetypes, [&components](const auto& archetype) { return archetype->components() == components; })));
+
+    if (target_index == _archetypes.size()) {
+      _archetypes.push_back(std::make_unique<archetype_type>(std::move(components)));
+    }
+
+    if (add) {
+      _archetypes[source_index]->set_add_edge(info->type, target_index);
+      _archetypes[target_index]->set_remove_edge(info->type, source_index);
+    } else {
+      _archetypes[source_index]->set_remove_edge(info->type, target_index);
+      _archetypes[target_index]->set_add_edge(info->type, source_index);
+    }
+
+    return target_index;
+  }
+
+  entity_storage_type _entities;
+  std::vector<location> _locations;
+  entity_type _free_list{null_entity};
+
+  std::vector<std::unique_ptr<archetype_type>> _archetypes;
+
+}; // class basic_archetype_registry
+
+namespace detail {
+
+struct registry_probe {
+  int value;
+}; // struct registry_probe
+
+} // namespace detail
+
+/**
+ * @brief Registries that provide the members shared by all storage backends: creating and destroying entities, adding,
+ * removing and getting components and iterating views with each. Generic code that has to work with every backend
+ * should be constrained with it and only rely on these members
+ *
+ * @note Groups, cached views, signals, change ticks, command buffers and parallel iteration are only provided by the
+ * sparse set backend
+ */
+template<typename Registry>
+concept registry_like = requires(Registry& registry, const Registry& const_registry, const typename Registry::entity_type entity, void (*func)(detail::registry_probe&)) {
+  typename Registry::entity_type;
+  typename Registry::size_type;
+  { registry.create_entity() } -> std::same_as<typename Registry::entity_type>;
+  registry.destroy_entity(entity);
+  { const_registry.is_valid_entity(entity) } -> std::same_as<bool>;
+  { const_registry.template has_component<detail::registry_probe>(entity) } -> std::same_as<bool>;
+  { registry.template add_component<detail::registry_probe>(entity, detail::registry_probe{}) } -> std::same_as<component_handle<detail::registry_probe>>;
+  registry.template remove_component<detail::registry_probe>(entity);
+  { registry.template get_component<detail::registry_probe>(entity) } -> std::same_as<component_handle<detail::registry_probe>>;
+  { registry.template try_get_component<detail::registry_probe>(entity) } -> std::same_as<component_handle<detail::registry_probe>>;
+  registry.template create_view<detail::registry_probe>().each(func);
+  registry.clear();
+};
+
+/** @brief Selects the registry that keeps every component type in its own sparse set storage */
+struct sparse_set_backend final { }; // struct sparse_set_backend
+
+/** @brief Selects the registry that keeps the entities with the same component types together in chunks */
+struct archetype_backend final { }; // struct archetype_backend
+
+template<typename Backend, typename Entity, allocator_for<Entity> Allocator>
+struct registry_backend;
+
+template<typename Entity, allocator_for<Entity> Allocator>
+struct registry_backend<sparse_set_backend, Entity, Allocator> {
+  using type = basic_registry<Entity, Allocator>;
+}; // struct registry_backend
+
+template<typename Entity, allocator_for<Entity> Allocator>
+struct registry_backend<archetype_backend, Entity, Allocator> {
+  using type = basic_archetype_registry<Entity, Allocator>;
+}; // struct registry_backend
+
+/**
+ * @brief Registry type for a storage backend. Both backends satisfy registry_like, code that is generic over the
+ * backend should not use any other member
+ *
+ * @tparam Backend sparse_set_backend or archetype_backend
+ * @tparam Entity Type of the entities
+ * @tparam Allocator Allocator type
+ */
+template<typename Backend, typename Entity = entity, allocator_for<Entity> Allocator = std::allocator<Entity>>
+requires (registry_like<typename registry_backend<Backend, Entity, Allocator>::type>)
+using registry_for = typename registry_backend<Backend, Entity, Allocator>::type;
+
+using archetype_registry = basic_archetype_registry<entity>;
+
+} // namespace ecs
+
+#endif // LIBECS_ARCHETYPE_HPP_
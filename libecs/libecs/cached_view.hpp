@@ -0,0 +1,242 @@
+#ifndef LIBECS_CACHED_VIEW_HPP_
+#define LIBECS_CACHED_VIEW_HPP_
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include <libecs/memory.hpp>
+#include <libecs/sparse_set.hpp>
+#include <libecs/type_list.hpp>
+#include <libecs/type_index.hpp>
+#include <libecs/iterable_adaptor.hpp>
+#include <libecs/view.hpp>
+#include <libecs/query_handler.hpp>
+
+namespace ecs {
+
+namespace detail {
+
+template<typename, typename>
+class cached_view_handler;
+
+/**
+ * @brief Keeps the entities that match a cached view in a packed set. Unlike groups it does not reorder any storage
+ *
+ * @tparam Get Types of the required storages
+ * @tparam Exclude Types of the excluded storages
+ */
+template<typename... Get, typename... Exclude>
+class cached_view_handler<get_t<Get...>, exclude_t<Exclude...>> final : public basic_query_handler<std::common_type_t<typename Get::key_type...>> {
+
+  using base_type = basic_query_handler<std::common_type_t<typename Get::key_type...>>;
+  using basic_common_type = std::common_type_t<typename Get::base_type...>;
+
+public:
+
+  using entity_type = typename base_type::entity_type;
+  using size_type = typename base_type::size_type;
+  using entity_set_type = key_set<entity_type, typename basic_common_type::allocator_type>;
+
+  cached_view_handler(const Get&... get, const Exclude&... exclude)
+  : _entities{},
+    _get{&get...},
+    _exclude{&exclude...},
+    _get_types{type_id<typename Get::value_type>()...},
+    _exclude_types{type_id<typename Exclude::value_type>()...} {
+    // [NOTE]: Every matching entity is in every required storage, so walking the smallest one finds all of them
+    const auto* lead = std::min({static_cast<const basic_common_type*>(&get)...}, [](const auto* lhs, const auto* rhs) { return lhs->size() < rhs->size(); });
+
+    for (const auto entity : *lead) {
+      if (_matches(entity, 0u)) {
+        _entities.add(entity);
+      }
+    }
+  }
+
+  auto entities() const noexcept -> const entity_set_type& {
+    return _entities;
+  }
+
+  auto clear() -> void override {
+    _entities.clear();
+  }
+
+  auto observes(const size_type type) const noexcept -> bool override {
+    return _requires(type) || _excludes(type);
+  }
+
+  auto on_construct(const size_type type, const entity_type& entity) -> void override {
+    if (_requires(type)) {
+      if (_matches(entity, 0u)) {
+        _entities.add(entity);
+      }
+    } else if (_excludes(type)) {
+      _entities.remove(entity);
+    }
+  }
+
+  auto on_destroy(const size_type type, const entity_type& entity) -> void override {
+    if (_requires(type)) {
+      _entities.remove(entity);
+    } else if (_excludes(type) && _matches(entity, 1u)) {
+      // [NOTE]: The excluded component is still assigned at this point, so it has to be the only one
+      _entities.add(entity);
+    }
+  }
+
+private:
+
+  auto _requires(const size_type type) const noexcept -> bool {
+    return std::ranges::find(_get_types, type) != _get_types.end();
+  }
+
+  auto _excludes(const size_type type) const noexcept -> bool {
+    return std::ranges::find(_exclude_types, type) != _exclude_types.end();
+  }
+
+  auto _matches(const entity_type& entity, const size_type excluded) const noexcept -> bool {
+    return std::apply([&entity](const auto*... storage) { return (storage->contains(entity) && ...); }, _get)
+      && std::apply([&entity](const auto*... storage) { return (size_type{0} + ... + static_cast<size_type>(storage->contains(entity))); }, _exclude) == excluded;
+  }
+
+  entity_set_type _entities;
+
+  std::tuple<const Get*...> _get;
+  std::tuple<const Exclude*...> _exclude;
+
+  std::array<size_type, sizeof...(Get)> _get_types;
+  std::array<size_type, sizeof...(Exclude)> _exclude_types;
+
+}; // class cached_view_handler
+
+} // namespace detail
+
+template<typename, typename>
+class basic_cached_view;
+
+/**
+ * @brief View whose matching entities are kept in a packed set by the registry. Iterating it walks that set and looks
+ * up the components of each entity directly, no storage is probed for entities that do not match
+ *
+ * @note Suits queries over many component types that match few entities. Every structural change of one of its
+ * component types updates the set, which makes adding and removing these components slightly more expensive
+ *
+ * @tparam Get Types of the required storages
+ * @tparam Exclude Types of the excluded storages
+ */
+template<typename... Get, typename... Exclude>
+class basic_cached_view<get_t<Get...>, exclude_t<Exclude...>> {
+
+  using underlying_type = std::common_type_t<typename Get::key_type...>;
+  using basic_common_type = std::common_type_t<typename Get::base_type...>;
+
+  using handler_type = detail::cached_view_handler<get_t<std::remove_const_t<Get>...>, exclude_t<std::remove_const_t<Exclude>...>>;
+  using container_storage_type = std::tuple<Get*...>;
+
+  template<typename Type>
+  inline static constexpr auto index_of = type_list_index_v<std::remove_const_t<Type>, type_list<typename Get::value_type...>>;
+
+  template<typename Entity, allocator_for<Entity> Allocator>
+  friend class basic_registry;
+
+public:
+
+  using entity_type = underlying_type;
+  using size_type = std::size_t;
+  using base_type = typename handler_type::entity_set_type;
+  using iterator = typename base_type::const_iterator;
+  using iterable = iterable_adaptor<detail::extended_view_iterator<iterator, get_t<Get...>, optional_t<>>>;
+
+  basic_cached_view() noexcept
+  : _entities{},
+    _containers{} { }
+
+  auto size() const noexcept -> size_type {
+    return _entities ? _entities->size() : size_type{0};
+  }
+
+  auto empty() const noexcept -> bool {
+    return size() == 0u;
+  }
+
+  auto begin() const noexcept -> iterator {
+    return handle().begin();
+  }
+
+  auto end() const noexcept -> iterator {
+    return handle().end();
+  }
+
+  /**
+   * @brief Gets the packed set of the matching entities
+   *
+   * @return
+   */
+  auto handle() const noexcept -> const base_type& {
+    return *_entities;
+  }
+
+  auto contains(const entity_type entity) const -> bool {
+    return _entities && _entities->contains(entity);
+  }
+
+  template<typename Type>
+  auto storage() const noexcept -> decltype(auto) {
+    return storage<index_of<Type>>();
+  }
+
+  template<std::size_t Index>
+  requires (Index < std::tuple_size_v<container_storage_type>)
+  auto storage() const noexcept -> decltype(auto) {
+    return *std::get<Index>(_containers);
+  }
+
+  template<typename... Types>
+  auto get(const entity_type entity) const -> decltype(auto) {
+    if constexpr(sizeof...(Types) == 0) {
+      return std::apply([entity](auto*... container) { return std::tuple_cat(container->as_tuple(entity)...); }, _containers);
+    } else if constexpr(sizeof...(Types) == 1) {
+      return (storage<index_of<Types>>().get(entity), ...);
+    } else {
+      return std::tuple_cat(storage<index_of<Types>>().as_tuple(entity)...);
+    }
+  }
+
+  auto each() const noexcept -> iterable {
+    using each_iterator = typename iterable::iterator;
+    return iterable{each_iterator{begin(), _containers}, each_iterator{end(), _containers}};
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view. The function takes the entity followed by the components,
+   * or the components alone. Empty components are not passed
+   *
+   * @note The set is walked back to front, so the function may remove components from the current entity
+   *
+   * @param func The function to invoke
+   */
+  template<typename Func>
+  auto each(Func func) const -> void {
+    for (auto index = size(); index != 0u; --index) {
+      const auto entity = handle().begin()[static_cast<std::ptrdiff_t>(index) - 1];
+      detail::invoke_each(func, entity, std::apply([entity](auto*... container) { return std::tuple_cat(container->as_tuple(entity)...); }, _containers));
+    }
+  }
+
+private:
+
+  basic_cached_view(const base_type& entities, Get&... get) noexcept
+  : _entities{&entities},
+    _containers{&get...} { }
+
+  const base_type* _entities;
+  container_storage_type _containers;
+
+}; // class basic_cached_view
+
+} // namespace ecs
+
+#endif // LIBECS_CACHED_VIEW_HPP_
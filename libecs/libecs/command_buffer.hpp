@@ -0,0 +1,297 @@
+#ifndef LIBECS_COMMAND_BUFFER_HPP_
+#define LIBECS_COMMAND_BUFFER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libecs/memory.hpp>
+#include <libecs/entity.hpp>
+#include <libecs/type_index.hpp>
+#include <libecs/registry.hpp>
+
+namespace ecs {
+
+/**
+ * @brief Records structural changes and applies them to a registry later, at a point where no view is iterated and no
+ * other thread accesses the registry
+ *
+ * @note A command buffer must only be used by one thread at a time. Threads that record concurrently use one buffer
+ * each. Recording does not allocate once the buffer has reached its working size, since applying or clearing it keeps
+ * its memory for reuse
+ *
+ * @tparam Entity Type of the entities
+ * @tparam Allocator Allocator type of the registry
+ */
+template<typename Entity, allocator_for<Entity> Allocator = std::allocator<Entity>>
+class basic_command_buffer {
+
+  using entity_traits = ecs::entity_traits<Entity>;
+
+  inline static constexpr auto block_size_v = std::size_t{16384u};
+
+  struct alignas(cache_line_size_v) block {
+    std::array<std::byte, block_size_v> data;
+  }; // struct block
+
+public:
+
+  using registry_type = basic_registry<Entity, Allocator>;
+  using entity_type = typename entity_traits::entity_type;
+  using size_type = std::size_t;
+
+private:
+
+  struct command {
+    auto (*apply)(registry_type&, command&, const entity_type&) -> void;
+    auto (*destroy)(command&) noexcept -> void;
+    entity_type entity;
+    size_type type;
+    size_type sequence;
+  }; // struct command
+
+public:
+
+  basic_command_buffer() = default;
+
+  basic_command_buffer(const basic_command_buffer&) = delete;
+
+  basic_command_buffer(basic_command_buffer&& other) noexcept
+  : _blocks{std::move(other._blocks)},
+    _block{std::exchange(other._block, 0u)},
+    _offset{std::exchange(other._offset, 0u)},
+    _commands{std::move(other._commands)},
+    _created{std::exchange(other._created, 0u)},
+    _created_entities{std::move(other._created_entities)},
+    _destroyed{std::move(other._destroyed)} { }
+
+  ~basic_command_buffer() {
+    clear();
+  }
+
+  auto operator=(const basic_command_buffer&) -> basic_command_buffer& = delete;
+
+  auto operator=(basic_command_buffer&& other) noexcept -> basic_command_buffer& {
+    if (this != &other) {
+      clear();
+
+      _blocks = std::move(other._blocks);
+      _block = std::exchange(other._block, 0u);
+      _offset = std::exchange(other._offset, 0u);
+      _commands = std::move(other._commands);
+      _created = std::exchange(other._created, 0u);
+      _created_entities = std::move(other._created_entities);
+      _destroyed = std::move(other._destroyed);
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Gets the number of recorded commands
+   *
+   * @return
+   */
+  auto size() const noexcept -> size_type {
+    return _created + _commands.size() + _destroyed.size();
+  }
+
+  auto empty() const noexcept -> bool {
+    return size() == 0u;
+  }
+
+  /**
+   * @brief Records the creation of an entity
+   *
+   * @return A placeholder for the entity. It can be passed to the other commands of this buffer, the real entity is
+   * created when the buffer is applied
+   */
+  auto create_entity() -> entity_type {
+    // [NOTE]: The registry never hands out the null version, so placeholders cannot be confused with real entities
+    return entity_traits::construct(static_cast<typename entity_traits::id_type>(_created++), entity_traits::to_version(null_entity));
+  }
+
+  /**
+   * @brief Records the destruction of an entity
+   *
+   * @param entity An entity of the registry or a placeholder of this buffer
+   */
+  auto destroy_entity(const entity_type& entity) -> void {
+    _destroyed.push_back(entity);
+  }
+
+  /**
+   * @brief Records the assignment of a component. The component is constructed now and moved into the registry when
+   * the buffer is applied
+   *
+   * @tparam Component Type of the component
+   *
+   * @param entity An entity of the registry or a placeholder of this buffer
+   * @param args Arguments to construct the component with
+   */
+  template<typename Component, typename... Args>
+  requires (std::constructible_from<std::remove_const_t<Component>, Args...>)
+  auto add_component(const entity_type& entity, Args&&... args) -> void {
+    using value_type = std::remove_const_t<Component>;
+
+    static_assert(alignof(value_type) <= cache_line_size_v, "Component alignment exceeds the alignment of the command buffer");
+    static_assert(_payload_offset<value_type>() + sizeof(value_type) <= block_size_v, "Component is too large for the command buffer");
+
+    auto& record = _record(entity, type_id<value_type>(), _payload_offset<value_type>() + sizeof(value_type), std::max(alignof(command), alignof(value_type)));
+
+    std::construct_at(_payload<value_type>(record), std::forward<Args>(args)...);
+
+    record.apply = [](registry_type& registry, command& self, const entity_type& target) -> void {
+      registry.template add_component<value_type>(target, std::move(*_payload<value_type>(self)));
+    };
+
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      record.destroy = [](command& self) noexcept -> void {
+        std::destroy_at(_payload<value_type>(self));
+      };
+    }
+  }
+
+  /**
+   * @brief Records the removal of a component
+   *
+   * @tparam Component Type of the component
+   *
+   * @param entity An entity of the registry or a placeholder of this buffer
+   */
+  template<typename Component>
+  auto remove_component(const entity_type& entity) -> void {
+    using value_type = std::remove_const_t<Component>;
+
+    auto& record = _record(entity, type_id<value_type>(), sizeof(command), alignof(command));
+
+    record.apply = [](registry_type& registry, [[maybe_unused]] command& self, const entity_type& target) -> void {
+      registry.template remove_component<value_type>(target);
+    };
+  }
+
+  /**
+   * @brief Applies all recorded commands to a registry and clears the buffer
+   *
+   * @note Entities are created first, all at once. Component commands follow, grouped by component type so that each
+   * storage is visited in one go. Commands for the same component type keep the order they were recorded in. Entities
+   * are destroyed last. Commands for entities that are not valid anymore are skipped. Entities that were reserved in
+   * the registry are flushed first, so commands may target them
+   *
+   * @param registry The registry to apply the commands to
+   */
+  auto apply(registry_type& registry) -> void {
+    try {
+      registry.flush();
+
+      _created_entities.resize(_created);
+      registry.create_entities(_created_entities.begin(), _created);
+
+      std::ranges::sort(_commands, [](const command* lhs, const command* rhs) {
+        return lhs->type < rhs->type || (lhs->type == rhs->type && lhs->sequence < rhs->sequence);
+      });
+
+      for (auto* record : _commands) {
+        if (const auto entity = _resolve(record->entity); registry.is_valid_entity(entity)) {
+          record->apply(registry, *record, entity);
+        }
+      }
+
+      for (auto& entity : _destroyed) {
+        entity = _resolve(entity);
+      }
+
+      registry.destroy_entities(_destroyed.begin(), _destroyed.end());
+    } catch (...) {
+      clear();
+      throw;
+    }
+
+    clear();
+  }
+
+  /**
+   * @brief Discards all recorded commands. The memory of the buffer is kept for reuse
+   */
+  auto clear() -> void {
+    for (auto* record : _commands) {
+      if (record->destroy) {
+        record->destroy(*record);
+      }
+    }
+
+    _commands.clear();
+    _block = 0u;
+    _offset = 0u;
+    _created = 0u;
+    _created_entities.clear();
+    _destroyed.clear();
+  }
+
+private:
+
+  template<typename Type>
+  static constexpr auto _payload_offset() noexcept -> size_type {
+    return (sizeof(command) + alignof(Type) - 1u) / alignof(Type) * alignof(Type);
+  }
+
+  template<typename Type>
+  static auto _payload(command& record) noexcept -> Type* {
+    return std::launder(reinterpret_cast<Type*>(reinterpret_cast<std::byte*>(&record) + _payload_offset<Type>()));
+  }
+
+  auto _resolve(const entity_type& entity) const noexcept -> entity_type {
+    if (entity_traits::to_version(entity) == entity_traits::to_version(null_entity) && entity != null_entity) {
+      const auto index = static_cast<size_type>(entity_traits::to_id(entity));
+      return index < _created_entities.size() ? _created_entities[index] : entity_type{null_entity};
+    }
+
+    return entity;
+  }
+
+  // [NOTE]: Records are placed back to back in fixed size blocks. Blocks are never moved, so payloads that are not trivially relocatable stay valid
+  auto _record(const entity_type& entity, const size_type type, const size_type size, const size_type alignment) -> command& {
+    auto offset = (_offset + alignment - 1u) / alignment * alignment;
+
+    if (_block == _blocks.size() || offset + size > block_size_v) {
+      if (_block != _blocks.size()) {
+        ++_block;
+      }
+
+      if (_block == _blocks.size()) {
+        _blocks.push_back(std::make_unique<block>());
+      }
+
+      offset = 0u;
+    }
+
+    auto* record = std::construct_at(reinterpret_cast<command*>(_blocks[_block]->data.data() + offset), command{nullptr, nullptr, entity, type, _commands.size()});
+
+    _commands.push_back(record);
+    _offset = offset + size;
+
+    return *record;
+  }
+
+  std::vector<std::unique_ptr<block>> _blocks;
+  size_type _block{0u};
+  size_type _offset{0u};
+
+  std::vector<command*> _commands;
+
+  size_type _created{0u};
+  std::vector<entity_type> _created_entities;
+  std::vector<entity_type> _destroyed;
+
+}; // class basic_command_buffer
+
+using command_buffer = basic_command_buffer<entity>;
+
+} // namespace ecs
+
+#endif // LIBECS_COMMAND_BUFFER_HPP_
@@ -0,0 +1,152 @@
+#ifndef LIBECS_COMPONENT_TRAITS_HPP_
+#define LIBECS_COMPONENT_TRAITS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ecs {
+
+namespace detail {
+
+template<auto Member>
+struct member_traits;
+
+template<typename Class, typename Type, Type Class::* Member>
+struct member_traits<Member> {
+  using class_type = Class;
+  using value_type = Type;
+}; // struct member_traits
+
+template<auto Member>
+using member_value_t = typename member_traits<Member>::value_type;
+
+template<auto Lhs, auto Rhs>
+inline constexpr auto is_same_member_v = [] {
+  if constexpr (std::is_same_v<decltype(Lhs), decltype(Rhs)>) {
+    return Lhs == Rhs;
+  } else {
+    return false;
+  }
+}();
+
+struct any_member {
+  template<typename Type>
+  operator Type() const;
+}; // struct any_member
+
+template<typename Type, std::size_t... Index>
+consteval auto is_aggregate_initializable(std::index_sequence<Index...>) -> bool {
+  return requires { Type{(static_cast<void>(Index), any_member{})...}; };
+}
+
+// [NOTE]: The number of initializers that aggregate initialization accepts is the number of data members, as long as none of them is an array
+template<typename Type, std::size_t Count = 0u>
+consteval auto aggregate_member_count() -> std::size_t {
+  if constexpr (is_aggregate_initializable<Type>(std::make_index_sequence<Count + 1u>{})) {
+    return aggregate_member_count<Type, Count + 1u>();
+  } else {
+    return Count;
+  }
+}
+
+template<typename Type>
+inline constexpr auto aggregate_member_count_v = aggregate_member_count<Type>();
+
+} // namespace detail
+
+/**
+ * @brief List of the data members of an aggregate component that are stored in separate arrays
+ *
+ * @tparam Members Pointers to the data members, in the order of their arrays
+ */
+template<auto... Members>
+struct fields_t final {
+  using value_types = std::tuple<detail::member_value_t<Members>...>;
+
+  inline static constexpr auto size = sizeof...(Members);
+
+  inline static constexpr auto members = std::make_tuple(Members...);
+
+  /** @brief Position of a data member in the list */
+  template<auto Member>
+  inline static constexpr auto index_of = [] {
+    constexpr auto matches = std::array<bool, sizeof...(Members)>{detail::is_same_member_v<Member, Members>...};
+    static_assert(std::ranges::find(matches, true) != matches.end(), "Member is not a field of the component");
+    return static_cast<std::size_t>(std::ranges::find(matches, true) - matches.begin());
+  }();
+
+  /** @brief Whether no data member is listed twice */
+  inline static constexpr auto is_unique = [] {
+    constexpr auto indices = std::array<std::size_t, sizeof...(Members)>{index_of<Members>...};
+
+    for (auto index = std::size_t{0}; index < indices.size(); ++index) {
+      if (indices[index] != index) {
+        return false;
+      }
+    }
+
+    return true;
+  }();
+
+  explicit constexpr fields_t() = default;
+}; // struct fields_t
+
+/** @brief Default configuration of the storage of a component */
+struct basic_component_traits {
+  /**
+   * @brief Number of entries per page in the sparse index of the storage. Must be a power of two. The default is also
+   * used by sparse sets that do not belong to a storage
+   */
+  inline static constexpr auto sparse_page_size_v = std::size_t{4096u};
+
+  /**
+   * @brief Number of components per page of the storage. Paged storages never move their components when they grow,
+   * so references and handles stay valid across insertions. Must be a power of two, 0 stores all components in a
+   * single contiguous array
+   */
+  inline static constexpr auto page_size_v = std::size_t{0u};
+
+  /**
+   * @brief Removes components in place instead of moving the last component into the hole. The hole is reused by the
+   * next insertion and storage::compact() defragments on demand. Requires a paged storage. The dense arrays of such a
+   * storage contain tombstones, so its values should be visited through views, which skip them
+   */
+  inline static constexpr auto in_place_delete_v = false;
+
+  /**
+   * @brief Keeps the tick at which each component was added and last changed, in an array parallel to the components.
+   * Mutable access through views, get_component and patch marks a component as changed. Ignored for empty types
+   */
+  inline static constexpr auto track_changes_v = false;
+
+  /**
+   * @brief Data members that are stored in one array each instead of storing whole components in a single array. The
+   * storage then hands out proxies instead of references and views and groups expose the array of each member.
+   * Requires an aggregate component with all of its data members listed and a storage without pages. Empty keeps
+   * whole components together
+   */
+  using fields_type = fields_t<>;
+}; // struct basic_component_traits
+
+/**
+ * @brief Per component configuration of the storage that holds the component. Specialize and derive from
+ * basic_component_traits to override single defaults
+ *
+ * @tparam Type Type of the component
+ */
+template<typename Type>
+struct component_traits : basic_component_traits { }; // struct component_traits
+
+/**
+ * @brief Component types whose data members are stored as a structure of arrays
+ */
+template<typename Type>
+concept soa_component = !std::is_empty_v<Type> && component_traits<Type>::fields_type::size != 0u;
+
+} // namespace ecs
+
+#endif // LIBECS_COMPONENT_TRAITS_HPP_
@@ -0,0 +1,257 @@
+#ifndef LIBECS_DELEGATE_HPP_
+#define LIBECS_DELEGATE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ecs {
+
+template<typename Callable, typename Return, typename... Args>
+concept callable = std::is_invocable_r_v<Return, Callable&, Args...>;
+
+/** @brief Exception type that is thrown when a delegate that does not hold a handle is invoked. */
+struct bad_delegate_call : std::runtime_error {
+  bad_delegate_call()
+  : std::runtime_error("bad_delegate_call") {}
+}; // struct bad_delegate_call
+
+template<typename Signature>
+class delegate;
+
+/**
+ * @brief Container for functors and lambdas that makes use of small object optimization.
+ *
+ * @note Functors that fit into three pointers and are nothrow move constructible are stored in place, this includes
+ * lambdas that capture a few pointers and bound member functions
+ *
+ * @tparam Return Return type of the delegate
+ * @tparam ...Args Argument types of the delegate
+ */
+template<typename Return, typename... Args>
+class delegate<Return(Args...)> {
+
+  inline static constexpr auto static_storage_size_v = sizeof(void*) * 3u;
+
+  union storage {
+    alignas(void*) std::byte static_storage[static_storage_size_v];
+    void* dynamic_storage;
+  }; // union storage
+
+public:
+
+  /**
+   * @brief Default constructor.
+   */
+  delegate() noexcept
+  : _vtable{nullptr} { }
+
+  /**
+   * @brief Constructs a delegate from a nullptr.
+   */
+  delegate(std::nullptr_t) noexcept
+  : _vtable{nullptr} { }
+
+  /**
+   * @brief Construct a delegate from a functor type.
+   *
+   * @tparam Callable Type of the functor
+   *
+   * @param callable Forwarded reference to a functor instance
+   */
+  template<typename Callable>
+  requires (!std::is_same_v<std::remove_cvref_t<Callable>, delegate> && callable<std::remove_cvref_t<Callable>, Return, Args...>) // Dont allow other delegates here!
+  delegate(Callable&& callable)
+  : _vtable{_create_vtable<std::remove_cvref_t<Callable>>()} {
+    _create_storage<std::remove_cvref_t<Callable>>(std::forward<Callable>(callable));
+  }
+
+  delegate(Return(*callable)(Args...))
+  : delegate{[callable](Args... args) -> Return { return std::invoke(callable, std::forward<Args>(args)...); }} { }
+
+  template<typename Class>
+  delegate(Class& instance, Return(Class::*method)(Args...))
+  : delegate{_wrap_method(&instance, method)} { }
+
+  template<typename Class>
+  delegate(Class& instance, Return(Class::*method)(Args...)const)
+  : delegate{_wrap_method(&instance, method)} { }
+
+  template<typename Class>
+  delegate(const Class& instance, Return(Class::*method)(Args...)const)
+  : delegate{_wrap_method(&instance, method)} { }
+
+  delegate(const delegate& other)
+  : _vtable{other._vtable} {
+    if (_vtable) {
+      _vtable->copy(other._storage, _storage);
+    }
+  }
+
+  delegate(delegate&& other) noexcept
+  : _vtable{std::exchange(other._vtable, nullptr)} {
+    if (_vtable) {
+      _vtable->move(other._storage, _storage);
+    }
+  }
+
+  ~delegate() {
+    if (_vtable) {
+      _vtable->destroy(_storage);
+    }
+  }
+
+  delegate& operator=(const delegate& other) {
+    if (this != &other) {
+      auto copy = other;
+      *this = std::move(copy);
+    }
+
+    return *this;
+  }
+
+  delegate& operator=(delegate&& other) noexcept {
+    if (this != &other) {
+      if (_vtable) {
+        _vtable->destroy(_storage);
+      }
+
+      _vtable = std::exchange(other._vtable, nullptr);
+
+      if (_vtable) {
+        _vtable->move(other._storage, _storage);
+      }
+    }
+
+    return *this;
+  }
+
+  auto invoke(Args... args) const -> Return {
+    if (!_vtable) {
+      throw bad_delegate_call{};
+    }
+
+    return _vtable->invoke(_storage, std::forward<Args>(args)...);
+  }
+
+  Return operator()(Args... args) const {
+    return invoke(std::forward<Args>(args)...);
+  }
+
+  auto is_valid() const noexcept {
+    return _vtable != nullptr;
+  }
+
+  operator bool() const noexcept {
+    return is_valid();
+  }
+
+private:
+
+  template<typename Callable>
+  inline static constexpr auto requires_dynamic_allocation_v = !(std::is_nothrow_move_constructible_v<Callable> && sizeof(Callable) <= static_storage_size_v && alignof(Callable) <= alignof(void*));
+
+  template<typename Class>
+  static auto _wrap_method(Class* instance, Return(Class::*method)(Args...)) {
+    return [instance, method](Args... args) -> Return { return std::invoke(method, instance, std::forward<Args>(args)...); };
+  }
+
+  template<typename Class>
+  static auto _wrap_method(Class* instance, Return(Class::*method)(Args...)const) {
+    return [instance, method](Args... args) -> Return { return std::invoke(method, instance, std::forward<Args>(args)...); };
+  }
+
+  template<typename Class>
+  static auto _wrap_method(const Class* instance, Return(Class::*method)(Args...)const) {
+    return [instance, method](Args... args) -> Return { return std::invoke(method, instance, std::forward<Args>(args)...); };
+  }
+
+  struct vtable {
+    Return(*invoke)(storage& storage, Args&&... args);
+    void(*copy)(const storage& source, storage& destination);
+    void(*move)(storage& source, storage& destination) noexcept;
+    void(*destroy)(storage& storage) noexcept;
+  };
+
+  template<typename Callable>
+  struct static_vtable {
+    static auto get(storage& storage) noexcept -> Callable& {
+      return *std::launder(reinterpret_cast<Callable*>(storage.static_storage));
+    }
+
+    static auto get(const storage& storage) noexcept -> const Callable& {
+      return *std::launder(reinterpret_cast<const Callable*>(storage.static_storage));
+    }
+
+    static Return invoke(storage& storage, Args&&... args) {
+      return std::invoke(get(storage), std::forward<Args>(args)...);
+    }
+
+    static void copy(const storage& source, storage& destination) {
+      std::construct_at(reinterpret_cast<Callable*>(destination.static_storage), get(source));
+    }
+
+    static void move(storage& source, storage& destination) noexcept {
+      std::construct_at(reinterpret_cast<Callable*>(destination.static_storage), std::move(get(source)));
+      destroy(source);
+    }
+
+    static void destroy(storage& storage) noexcept {
+      std::destroy_at(&get(storage));
+    }
+  };
+
+  template<typename Callable>
+  struct dynamic_vtable {
+    static Return invoke(storage& storage, Args&&... args) {
+      return std::invoke(*static_cast<Callable*>(storage.dynamic_storage), std::forward<Args>(args)...);
+    }
+
+    static void copy(const storage& source, storage& destination) {
+      destination.dynamic_storage = new Callable(*static_cast<const Callable*>(source.dynamic_storage));
+    }
+
+    static void move(storage& source, storage& destination) noexcept {
+      destination.dynamic_storage = std::exchange(source.dynamic_storage, nullptr);
+    }
+
+    static void destroy(storage& storage) noexcept {
+      delete static_cast<Callable*>(storage.dynamic_storage);
+    }
+  };
+
+  template<typename Callable>
+  static const vtable* _create_vtable() {
+    using vtable_type = std::conditional_t<requires_dynamic_allocation_v<Callable>, dynamic_vtable<Callable>, static_vtable<Callable>>;
+
+    static constexpr auto instance = vtable{
+      vtable_type::invoke,
+      vtable_type::copy,
+      vtable_type::move,
+      vtable_type::destroy
+    };
+
+    return &instance;
+  }
+
+  template<typename Callable, typename Type>
+  auto _create_storage(Type&& callable) -> void {
+    if constexpr (requires_dynamic_allocation_v<Callable>) {
+      _storage.dynamic_storage = new Callable(std::forward<Type>(callable));
+    } else {
+      std::construct_at(reinterpret_cast<Callable*>(_storage.static_storage), std::forward<Type>(callable));
+    }
+  }
+
+  const vtable* _vtable{};
+  mutable storage _storage{};
+
+}; // class delegate
+
+} // namespace ecs
+
+#endif // LIBECS_DELEGATE_HPP_
@@ -3,6 +3,11 @@
 
 #include <libecs/entity.hpp>
 #include <libecs/registry.hpp>
+#include <libecs/archetype.hpp>
+#include <libecs/executor.hpp>
+#include <libecs/scheduler.hpp>
+#include <libecs/command_buffer.hpp>
+#include <libecs/observer.hpp>
 #include <libecs/script.hpp>
 #include <libecs/scene.hpp>
 #include <libecs/vector3.hpp>
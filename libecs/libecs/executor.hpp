@@ -0,0 +1,575 @@
+#ifndef LIBECS_EXECUTOR_HPP_
+#define LIBECS_EXECUTOR_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libecs/task_graph.hpp>
+#include <libecs/work_stealing_queue.hpp>
+
+namespace ecs {
+
+/**
+ * @brief Runs task flows on a pool of worker threads. Every worker owns a work stealing queue: tasks that become ready
+ * on a worker are pushed to its own queue and idle workers steal from the others
+ *
+ * @note Running a task flow does not allocate per run apart from its future, dynamic tasks allocate the nodes of
+ * their subflows. Once a task has thrown, no further task of the same run is started and the successors of running
+ * tasks are not scheduled, the run completes with the exception as soon as the running tasks have returned
+ */
+class executor {
+
+  struct worker {
+    worker(executor& owner, const std::size_t id)
+    : owner{&owner},
+      id{id},
+      queue{},
+      random{static_cast<std::minstd_rand::result_type>(id + 1u)} { }
+
+    executor* owner;
+    std::size_t id;
+    work_stealing_queue<node*> queue;
+    std::minstd_rand random;
+  }; // struct worker
+
+public:
+
+  using size_type = std::size_t;
+
+  /**
+   * @brief Starts the worker threads
+   *
+   * @param workers Number of worker threads
+   */
+  explicit executor(const size_type workers = std::max(std::thread::hardware_concurrency(), 1u)) {
+    const auto count = std::max(workers, size_type{1});
+
+    _workers.reserve(count);
+
+    for (auto id = size_type{0}; id < count; ++id) {
+      _workers.push_back(std::make_unique<worker>(*this, id));
+    }
+
+    _threads.reserve(count);
+
+    for (auto& worker : _workers) {
+      _threads.emplace_back([this, &worker]() { _run(*worker); });
+    }
+  }
+
+  executor(const executor&) = delete;
+
+  executor(executor&&) = delete;
+
+  ~executor() {
+    wait_for_all();
+
+    {
+      const auto lock = std::lock_guard{_mutex};
+      _stop = true;
+    }
+
+    _wake.notify_all();
+
+    for (auto& thread : _threads) {
+      thread.join();
+    }
+  }
+
+  auto operator=(const executor&) -> executor& = delete;
+
+  auto operator=(executor&&) -> executor& = delete;
+
+  auto size() const noexcept -> size_type {
+    return _workers.size();
+  }
+
+  /**
+   * @brief Runs a task flow once
+   *
+   * @param flow The task flow. Must stay alive until the returned future is ready
+   *
+   * @return A future that becomes ready when the run has completed and holds the first exception thrown by a task
+   */
+  auto run(task_flow& flow) -> std::future<void> {
+    return run_n(flow, 1u);
+  }
+
+  /**
+   * @brief Runs a task flow a number of times in a row
+   *
+   * @param flow The task flow. Must stay alive until the returned future is ready
+   * @param count Number of runs
+   *
+   * @return A future that becomes ready when the last run has completed
+   */
+  auto run_n(task_flow& flow, const size_type count) -> std::future<void> {
+    return run_until(flow, [remaining = count]() mutable { return remaining-- == 0u; });
+  }
+
+  /**
+   * @brief Runs a task flow until a predicate returns true. The predicate is checked before every run, on the thread
+   * that completed the previous run
+   *
+   * @note Runs of the same task flow that are requested while it is running are queued
+   *
+   * @param flow The task flow. Must stay alive until the returned future is ready
+   * @param predicate Predicate that returns true to stop
+   *
+   * @return A future that becomes ready when the predicate returned true or a task has thrown
+   */
+  template<typename Predicate>
+  requires (std::is_invocable_r_v<bool, Predicate&>)
+  auto run_until(task_flow& flow, Predicate predicate) -> std::future<void> {
+    {
+      const auto lock = std::lock_guard{_mutex};
+      ++_topologies;
+    }
+
+    auto lock = std::unique_lock{flow._mutex};
+
+    auto& topology = flow._topologies.emplace_back(flow, std::move(predicate));
+    auto future = topology._promise.get_future();
+
+    // [NOTE]: Only the run that finds the queue empty starts, the others are started by the run before them
+    if (flow._topologies.size() == 1u) {
+      lock.unlock();
+      _start(nullptr, topology);
+    }
+
+    return future;
+  }
+
+  /**
+   * @brief Invokes a function for every index in [first, last) and waits for all invocations to finish. The indices
+   * are handed out in chunks of grain consecutive indices to the workers and to the calling thread
+   *
+   * @note Invocations run concurrently on different threads. Loops may be started from tasks of this executor and may
+   * be nested, the waiting worker runs other tasks until the loop is done
+   *
+   * @param first The first index
+   * @param last The index past the last index
+   * @param grain Number of consecutive indices that one thread claims at a time
+   * @param func Function that takes an index
+   *
+   * @throws The first exception that was thrown by one of the invocations. Chunks that have not been claimed yet are
+   * skipped once an invocation has thrown
+   */
+  template<typename Func>
+  requires (std::invocable<Func&, size_type>)
+  auto parallel_for(const size_type first, const size_type last, const size_type grain, Func func) -> void {
+    if (first >= last) {
+      return;
+    }
+
+    const auto step = std::max(grain, size_type{1});
+    const auto chunks = (last - first - 1u) / step + 1u;
+
+    if (chunks == 1u) {
+      for (auto index = first; index < last; ++index) {
+        func(index);
+      }
+
+      return;
+    }
+
+    auto next = std::atomic<size_type>{first};
+    auto mutex = std::mutex{};
+    auto exception = std::exception_ptr{};
+
+    // [NOTE]: Exceptions are kept by the loop instead of the run of a task flow, so they reach the caller of the loop
+    auto work = [&]() {
+      for (auto begin = next.fetch_add(step, std::memory_order_relaxed); begin < last; begin = next.fetch_add(step, std::memory_order_relaxed)) {
+        try {
+          for (auto index = begin, end = begin + std::min(step, last - begin); index < end; ++index) {
+            func(index);
+          }
+        } catch (...) {
+          const auto lock = std::lock_guard{mutex};
+
+          if (!exception) {
+            exception = std::current_exception();
+          }
+
+          next.store(last, std::memory_order_relaxed);
+        }
+      }
+    };
+
+    auto spawn = [&work, count = std::min(chunks, size())](subflow& flow) {
+      for (auto index = size_type{0}; index < count; ++index) {
+        flow.emplace([&work]() { work(); });
+      }
+    };
+
+    if (_current && _current->owner == this) {
+      // [NOTE]: Inside of a worker the loop is joined like a subflow, the worker takes part by running the loop tasks
+      auto parent = node{std::in_place_type<node::dynamic>, node::dynamic{std::move(spawn), graph{}}};
+      _invoke_dynamic(*_current, &parent, std::get<node::dynamic>(parent._handle));
+    } else {
+      auto flow = task_flow{};
+      flow.emplace(std::move(spawn));
+
+      auto done = run(flow);
+      work();
+      done.get();
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  /**
+   * @brief Invokes a function for every index in [0, count) and waits for all invocations to finish
+   *
+   * @param count Number of indices
+   * @param func Function that takes an index
+   *
+   * @throws The first exception that was thrown by one of the invocations
+   */
+  template<typename Func>
+  requires (std::invocable<Func&, size_type>)
+  auto parallel_for(const size_type count, Func func) -> void {
+    parallel_for(0u, count, 1u, std::move(func));
+  }
+
+  /**
+   * @brief Blocks until all runs that have been requested are completed
+   */
+  auto wait_for_all() -> void {
+    auto lock = std::unique_lock{_mutex};
+    _idle.wait(lock, [this]() { return _topologies == 0u; });
+  }
+
+private:
+
+  auto _run(worker& worker) -> void {
+    _current = &worker;
+    _run_until(worker, [this]() { return _stop; });
+  }
+
+  // [NOTE]: The predicate is checked with the mutex held, a thread that makes it true has to lock the mutex and notify the workers
+  template<typename Predicate>
+  auto _run_until(worker& worker, Predicate done) -> void {
+    while (true) {
+      if (auto* task = _find_task(worker); task) {
+        _invoke(worker, task);
+        continue;
+      }
+
+      auto lock = std::unique_lock{_mutex};
+
+      if (done()) {
+        return;
+      }
+
+      if (!_shared.empty()) {
+        continue;
+      }
+
+      // [NOTE]: Workers announce that they are about to sleep before they scan the queues a last time. A task that is pushed after the scan sees the announcement and wakes them
+      const auto epoch = _epoch;
+      _sleeping.fetch_add(1u, std::memory_order_seq_cst);
+      lock.unlock();
+
+      auto* task = _steal(worker);
+
+      if (!task) {
+        lock.lock();
+        _wake.wait(lock, [this, &done, epoch]() { return done() || _epoch != epoch || !_shared.empty(); });
+        lock.unlock();
+      }
+
+      _sleeping.fetch_sub(1u, std::memory_order_seq_cst);
+
+      if (task) {
+        _invoke(worker, task);
+      }
+    }
+  }
+
+  auto _find_task(worker& worker) -> node* {
+    if (const auto task = worker.queue.pop(); task) {
+      return *task;
+    }
+
+    if (auto* task = _steal(worker); task) {
+      return task;
+    }
+
+    const auto lock = std::lock_guard{_mutex};
+
+    if (_shared.empty()) {
+      return nullptr;
+    }
+
+    auto* task = _shared.front();
+    _shared.pop_front();
+
+    return task;
+  }
+
+  auto _steal(worker& worker) -> node* {
+    const auto count = _workers.size();
+    const auto first = static_cast<size_type>(worker.random()) % count;
+
+    for (auto round = 0; round < 2; ++round) {
+      for (auto offset = size_type{0}; offset < count; ++offset) {
+        if (auto& victim = *_workers[(first + offset) % count]; &victim != &worker) {
+          if (const auto task = victim.queue.steal(); task) {
+            return *task;
+          }
+        }
+      }
+    }
+
+    return nullptr;
+  }
+
+  auto _schedule(worker& worker, node* task) -> void {
+    worker.queue.push(task);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_sleeping.load(std::memory_order_relaxed) != 0u) {
+      {
+        const auto lock = std::lock_guard{_mutex};
+        ++_epoch;
+      }
+
+      _wake.notify_one();
+    }
+  }
+
+  // [NOTE]: The worker that joins a subflow may be asleep, it cannot be told apart from the others so all of them are woken
+  auto _notify_join() -> void {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_sleeping.load(std::memory_order_relaxed) != 0u) {
+      {
+        const auto lock = std::lock_guard{_mutex};
+        ++_epoch;
+      }
+
+      _wake.notify_all();
+    }
+  }
+
+  // [NOTE]: Tasks of parallel loops have no topology, they keep their exceptions to themselves
+  auto _invoke(worker& worker, node* task) -> void {
+    auto* topology = task->_topology;
+    auto selected = -1;
+
+    try {
+      if (topology && topology->_cancelled.load(std::memory_order_relaxed)) {
+        // [NOTE]: Tasks that were scheduled before another task of the run has thrown are skipped
+      } else if (auto* work = std::get_if<node::fixed>(&task->_handle); work) {
+        work->work();
+      } else if (auto* work = std::get_if<node::dynamic>(&task->_handle); work) {
+        _invoke_dynamic(worker, task, *work);
+      } else if (auto* work = std::get_if<node::condition>(&task->_handle); work) {
+        selected = work->work();
+      }
+    } catch (...) {
+      // [NOTE]: An exception that escapes a loop task has no run to cancel and is dropped
+      if (topology) {
+        const auto lock = std::lock_guard{topology->_mutex};
+
+        if (!topology->_exception) {
+          topology->_exception = std::current_exception();
+        }
+
+        topology->_cancelled.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    // [NOTE]: Every task either belongs to a subflow or a loop, which have a parent, or to a run, which has a topology
+    auto* parent = task->_parent;
+    auto& pending = parent ? parent->_pending : topology->_pending;
+
+    // [NOTE]: The join counter is restored before any successor runs, so loops built from condition tasks can run the task again
+    task->_join_counter.store(task->_strong_dependents, std::memory_order_relaxed);
+
+    if (topology && topology->_cancelled.load(std::memory_order_relaxed)) {
+      // [NOTE]: Successors of a cancelled run are not scheduled, the run completes once the running tasks have returned
+    } else if (task->_is_condition()) {
+      if (selected >= 0 && static_cast<size_type>(selected) < task->_successors.size()) {
+        pending.fetch_add(1u, std::memory_order_relaxed);
+        _schedule(worker, task->_successors[static_cast<size_type>(selected)]);
+      }
+    } else {
+      for (auto* successor : task->_successors) {
+        if (successor->_join_counter.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+          pending.fetch_add(1u, std::memory_order_relaxed);
+          _schedule(worker, successor);
+        }
+      }
+    }
+
+    // [NOTE]: Once pending drops the run may complete on another thread, so the task is not touched afterwards
+    if (pending.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+      if (parent) {
+        _notify_join();
+      } else {
+        _tear_down(worker, *topology);
+      }
+    }
+  }
+
+  // [NOTE]: The worker keeps running other tasks until the subflow has completed, so joining it never blocks a thread
+  auto _invoke_dynamic(worker& worker, node* parent, node::dynamic& work) -> void {
+    work.subgraph.clear();
+
+    auto flow = subflow{work.subgraph};
+    work.work(flow);
+
+    auto sources = size_type{0};
+
+    for (auto& child : work.subgraph._nodes) {
+      child->_prepare(parent->_topology, parent);
+      sources += child->_dependents.empty() ? 1u : 0u;
+    }
+
+    if (sources == 0u) {
+      return;
+    }
+
+    parent->_pending.store(sources, std::memory_order_relaxed);
+
+    for (auto& child : work.subgraph._nodes) {
+      if (child->_dependents.empty()) {
+        _schedule(worker, child.get());
+      }
+    }
+
+    _run_until(worker, [parent]() { return parent->_pending.load(std::memory_order_seq_cst) == 0u; });
+  }
+
+  auto _start(worker* worker, topology& topology) -> void {
+    if (topology._predicate() || !_set_up(worker, topology)) {
+      _finish(worker, topology);
+    }
+  }
+
+  auto _set_up(worker* worker, topology& topology) -> bool {
+    auto& nodes = topology._flow->_graph._nodes;
+
+    topology._cancelled.store(false, std::memory_order_relaxed);
+    auto sources = size_type{0};
+    auto* last = static_cast<node*>(nullptr);
+
+    for (auto& task : nodes) {
+      task->_prepare(&topology, nullptr);
+
+      if (task->_dependents.empty()) {
+        ++sources;
+        last = task.get();
+      }
+    }
+
+    if (sources == 0u) {
+      return false;
+    }
+
+    topology._pending.store(sources, std::memory_order_relaxed);
+
+    if (worker) {
+      // [NOTE]: The run may complete as soon as the last source is scheduled, so the graph is not touched afterwards
+      for (auto& task : nodes) {
+        if (task.get() != last && task->_dependents.empty()) {
+          _schedule(*worker, task.get());
+        }
+      }
+
+      _schedule(*worker, last);
+    } else {
+      {
+        const auto lock = std::lock_guard{_mutex};
+
+        for (auto& task : nodes) {
+          if (task->_dependents.empty()) {
+            _shared.push_back(task.get());
+          }
+        }
+
+        ++_epoch;
+      }
+
+      _wake.notify_all();
+    }
+
+    return true;
+  }
+
+  auto _tear_down(worker& worker, topology& topology) -> void {
+    if (!topology._exception && !topology._predicate() && _set_up(&worker, topology)) {
+      return;
+    }
+
+    _finish(&worker, topology);
+  }
+
+  auto _finish(worker* worker, topology& topology) -> void {
+    auto& flow = *topology._flow;
+
+    auto promise = std::move(topology._promise);
+    auto exception = topology._exception;
+
+    auto lock = std::unique_lock{flow._mutex};
+
+    flow._topologies.pop_front();
+    auto* next = flow._topologies.empty() ? nullptr : &flow._topologies.front();
+
+    lock.unlock();
+
+    if (next) {
+      _start(worker, *next);
+    }
+
+    // [NOTE]: The task flow may be destroyed as soon as the promise is satisfied, so it is not touched afterwards
+    if (exception) {
+      promise.set_exception(exception);
+    } else {
+      promise.set_value();
+    }
+
+    {
+      const auto lock = std::lock_guard{_mutex};
+      --_topologies;
+    }
+
+    _idle.notify_all();
+  }
+
+  std::vector<std::unique_ptr<worker>> _workers;
+  std::vector<std::thread> _threads;
+
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _idle;
+  std::deque<node*> _shared;
+  size_type _epoch{0u};
+  size_type _topologies{0u};
+  std::atomic<size_type> _sleeping{0u};
+  bool _stop{false};
+
+  inline static thread_local worker* _current{nullptr};
+
+}; // class executor
+
+} // namespace ecs
+
+#endif // LIBECS_EXECUTOR_HPP_
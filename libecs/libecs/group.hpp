@@ -0,0 +1,387 @@
+#ifndef LIBECS_GROUP_HPP_
+#define LIBECS_GROUP_HPP_
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include <libecs/memory.hpp>
+#include <libecs/type_list.hpp>
+#include <libecs/type_index.hpp>
+#include <libecs/component_traits.hpp>
+#include <libecs/iterable_adaptor.hpp>
+#include <libecs/query_handler.hpp>
+#include <libecs/view.hpp>
+
+namespace ecs {
+
+namespace detail {
+
+/**
+ * @brief Type erased part of a group that the registry notifies about structural changes
+ *
+ * @tparam Entity Type of the entities
+ */
+template<typename Entity>
+class basic_group_handler : public basic_query_handler<Entity> {
+
+public:
+
+  using entity_type = Entity;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Gets the number of entities at the front of the owned storages that match the group
+   *
+   * @return
+   */
+  auto length() const noexcept -> const size_type& {
+    return _length;
+  }
+
+  auto clear() -> void override {
+    _length = 0u;
+  }
+
+  /**
+   * @brief Checks if the group owns the storage of a component type
+   *
+   * @param type Type id of the component
+   *
+   * @return true if the storage is owned by the group
+   */
+  virtual auto owns(const size_type type) const noexcept -> bool = 0;
+
+protected:
+
+  size_type _length{0u};
+
+}; // class basic_group_handler
+
+template<typename, typename, typename>
+class group_handler;
+
+/**
+ * @brief Keeps the entities that match a group packed at the front of the owned storages, in the same order in all
+ * of them
+ *
+ * @tparam Owned Types of the owned storages
+ * @tparam Get Types of the required storages
+ * @tparam Exclude Types of the excluded storages
+ */
+template<typename... Owned, typename... Get, typename... Exclude>
+class group_handler<owned_t<Owned...>, get_t<Get...>, exclude_t<Exclude...>> final : public basic_group_handler<std::common_type_t<typename Owned::key_type...>> {
+
+  using base_type = basic_group_handler<std::common_type_t<typename Owned::key_type...>>;
+
+  static_assert((!component_traits<typename Owned::value_type>::in_place_delete_v && ...), "Owned storages must not use in place deletion");
+
+public:
+
+  using entity_type = typename base_type::entity_type;
+  using size_type = typename base_type::size_type;
+
+  group_handler(Owned&... owned, const Get&... get, const Exclude&... exclude)
+  : _owned{&owned...},
+    _get{&get...},
+    _exclude{&exclude...},
+    _owned_types{type_id<typename Owned::value_type>()...},
+    _get_types{type_id<typename Get::value_type>()...},
+    _exclude_types{type_id<typename Exclude::value_type>()...} {
+    // [NOTE]: Entities are only ever swapped towards the front, so every entity of the leading storage is visited once
+    const auto& lead = *std::get<0>(_owned);
+
+    for (auto index = size_type{0}; index < lead.size(); ++index) {
+      if (const auto entity = lead.at(index); _matches(entity, 0u)) {
+        _enter(entity);
+      }
+    }
+  }
+
+  auto owns(const size_type type) const noexcept -> bool override {
+    return std::ranges::find(_owned_types, type) != _owned_types.end();
+  }
+
+  auto observes(const size_type type) const noexcept -> bool override {
+    return _requires(type) || _excludes(type);
+  }
+
+  auto on_construct(const size_type type, const entity_type& entity) -> void override {
+    if (_requires(type)) {
+      if (!_contains(entity) && _matches(entity, 0u)) {
+        _enter(entity);
+      }
+    } else if (_excludes(type) && _contains(entity)) {
+      _leave(entity);
+    }
+  }
+
+  auto on_destroy(const size_type type, const entity_type& entity) -> void override {
+    if (_requires(type)) {
+      if (_contains(entity)) {
+        _leave(entity);
+      }
+    } else if (_excludes(type) && !_contains(entity) && _matches(entity, 1u)) {
+      // [NOTE]: The excluded component is still assigned at this point, so it has to be the only one
+      _enter(entity);
+    }
+  }
+
+private:
+
+  auto _requires(const size_type type) const noexcept -> bool {
+    return owns(type) || std::ranges::find(_get_types, type) != _get_types.end();
+  }
+
+  auto _excludes(const size_type type) const noexcept -> bool {
+    return std::ranges::find(_exclude_types, type) != _exclude_types.end();
+  }
+
+  auto _contains(const entity_type& entity) const -> bool {
+    const auto& lead = *std::get<0>(_owned);
+    return lead.contains(entity) && lead.index(entity) < base_type::_length;
+  }
+
+  auto _matches(const entity_type& entity, const size_type excluded) const noexcept -> bool {
+    return std::apply([&entity](const auto*... storage) { return (storage->contains(entity) && ...); }, _owned)
+      && std::apply([&entity](const auto*... storage) { return (storage->contains(entity) && ...); }, _get)
+      && std::apply([&entity](const auto*... storage) { return (size_type{0} + ... + static_cast<size_type>(storage->contains(entity))); }, _exclude) == excluded;
+  }
+
+  auto _enter(const entity_type& entity) -> void {
+    std::apply([this, &entity](auto*... storage) { (_move_to(*storage, entity, base_type::_length), ...); }, _owned);
+    ++base_type::_length;
+  }
+
+  auto _leave(const entity_type& entity) -> void {
+    --base_type::_length;
+    std::apply([this, &entity](auto*... storage) { (_move_to(*storage, entity, base_type::_length), ...); }, _owned);
+  }
+
+  template<typename Storage>
+  static auto _move_to(Storage& storage, const entity_type& entity, const size_type position) -> void {
+    storage.swap_elements(storage.at(position), entity);
+  }
+
+  std::tuple<Owned*...> _owned;
+  std::tuple<const Get*...> _get;
+  std::tuple<const Exclude*...> _exclude;
+
+  std::array<size_type, sizeof...(Owned)> _owned_types;
+  std::array<size_type, sizeof...(Get)> _get_types;
+  std::array<size_type, sizeof...(Exclude)> _exclude_types;
+
+}; // class group_handler
+
+template<typename, typename>
+class group_iterator;
+
+template<typename... Owned, typename... Get>
+class group_iterator<type_list<Owned...>, type_list<Get...>> final {
+
+  using iterator_type = typename std::common_type_t<typename Owned::base_type...>::const_iterator;
+
+public:
+
+  using difference_type = std::ptrdiff_t;
+  using value_type = decltype(std::tuple_cat(std::make_tuple(*std::declval<iterator_type>()), dense_as_tuple(std::declval<Owned&>(), 0)..., std::declval<Get&>().as_tuple({})...));
+  using pointer = input_iterator_pointer<value_type>;
+  using reference = value_type;
+  using iterator_category = std::input_iterator_tag;
+
+  constexpr group_iterator()
+  : _iterator{},
+    _index{},
+    _owned{},
+    _get{} { }
+
+  group_iterator(iterator_type iterator, const difference_type index, std::tuple<Owned*...> owned, std::tuple<Get*...> get)
+  : _iterator{iterator},
+    _index{index},
+    _owned{owned},
+    _get{get} { }
+
+  auto operator++() noexcept -> group_iterator& {
+    --_index;
+    return *this;
+  }
+
+  auto operator++(int) noexcept -> group_iterator {
+    auto copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  // [NOTE]: Owned components sit at the same index as the entity, only the components that are not owned are looked up
+  [[nodiscard]] auto operator*() const noexcept -> reference {
+    const auto index = _index - 1;
+    const auto entity = _iterator[index];
+
+    return std::tuple_cat(
+      std::make_tuple(entity),
+      std::apply([index](auto*... container) { return std::tuple_cat(dense_as_tuple(*container, index)...); }, _owned),
+      std::apply([entity](auto*... container) { return std::tuple_cat(container->as_tuple(entity)...); }, _get)
+    );
+  }
+
+  [[nodiscard]] auto operator->() const noexcept -> pointer {
+    return operator*();
+  }
+
+  friend auto operator==(const group_iterator& lhs, const group_iterator& rhs) noexcept -> bool {
+    return lhs._index == rhs._index;
+  }
+
+private:
+
+  iterator_type _iterator;
+  difference_type _index;
+  std::tuple<Owned*...> _owned;
+  std::tuple<Get*...> _get;
+
+}; // class group_iterator
+
+} // namespace detail
+
+template<typename, typename, typename>
+class basic_group;
+
+/**
+ * @brief Group that owns the storages of some of its component types. The matching entities are kept at the front of
+ * the owned storages in the same order, so iterating the group walks the owned arrays in lockstep
+ *
+ * @note Owned storages are reordered whenever an entity enters or leaves the group. Adding or removing owned, required
+ * or excluded components while iterating the group or the owned storages invalidates the iteration. The only exception
+ * is each(), which walks the group back to front, so components may be removed from its current entity
+ *
+ * @tparam Owned Types of the owned storages
+ * @tparam Get Types of the required storages
+ * @tparam Exclude Types of the excluded storages
+ */
+template<typename... Owned, typename... Get, typename... Exclude>
+class basic_group<owned_t<Owned...>, get_t<Get...>, exclude_t<Exclude...>> {
+
+  using underlying_type = std::common_type_t<typename Owned::key_type..., typename Get::key_type...>;
+  using basic_common_type = std::common_type_t<typename Owned::base_type..., typename Get::base_type...>;
+
+  using container_storage_type = std::tuple<Owned*..., Get*...>;
+
+  template<typename Type>
+  inline static constexpr auto index_of = type_list_index_v<std::remove_const_t<Type>, type_list<typename Owned::value_type..., typename Get::value_type...>>;
+
+  template<typename Entity, allocator_for<Entity> Allocator>
+  friend class basic_registry;
+
+public:
+
+  using entity_type = underlying_type;
+  using size_type = std::size_t;
+  using base_type = basic_common_type;
+  using iterator = typename base_type::const_iterator;
+  using iterable = iterable_adaptor<detail::group_iterator<type_list<Owned...>, type_list<Get...>>>;
+
+  basic_group() noexcept
+  : _length{},
+    _containers{} { }
+
+  auto size() const noexcept -> size_type {
+    return _length ? *_length : size_type{0};
+  }
+
+  auto empty() const noexcept -> bool {
+    return size() == 0u;
+  }
+
+  auto begin() const noexcept -> iterator {
+    return handle().begin();
+  }
+
+  auto end() const noexcept -> iterator {
+    return std::next(handle().begin(), static_cast<std::ptrdiff_t>(size()));
+  }
+
+  /**
+   * @brief Gets the leading owned storage. Its first size() entities are the entities of the group
+   *
+   * @return
+   */
+  auto handle() const noexcept -> const base_type& {
+    return *std::get<0>(_containers);
+  }
+
+  auto contains(const entity_type entity) const -> bool {
+    return handle().contains(entity) && handle().index(entity) < size();
+  }
+
+  template<typename Type>
+  auto storage() const noexcept -> decltype(auto) {
+    return storage<index_of<Type>>();
+  }
+
+  template<std::size_t Index>
+  requires (Index < std::tuple_size_v<container_storage_type>)
+  auto storage() const noexcept -> decltype(auto) {
+    return *std::get<Index>(_containers);
+  }
+
+  template<typename... Types>
+  auto get(const entity_type entity) const -> decltype(auto) {
+    if constexpr(sizeof...(Types) == 0) {
+      return std::apply([entity](auto*... container) { return std::tuple_cat(container->as_tuple(entity)...); }, _containers);
+    } else if constexpr(sizeof...(Types) == 1) {
+      return (storage<index_of<Types>>().get(entity), ...);
+    } else {
+      return std::tuple_cat(storage<index_of<Types>>().as_tuple(entity)...);
+    }
+  }
+
+  /**
+   * @brief Gets the array of one data member of an owned component, in the same order as the entities of the group
+   *
+   * @note Only for owned components that are stored as structure of arrays. Owned arrays are packed in the order of
+   * the group, so the arrays of different owned components line up index by index
+   *
+   * @tparam Member Pointer to the data member
+   *
+   * @return
+   */
+  template<auto Member>
+  requires ((std::is_same_v<typename detail::member_traits<Member>::class_type, typename Owned::value_type> || ...) && soa_component<typename detail::member_traits<Member>::class_type>)
+  auto field() const noexcept -> decltype(auto) {
+    return storage<typename detail::member_traits<Member>::class_type>().template field<Member>().first(size());
+  }
+
+  /**
+   * @brief Gets an iterable that yields the entity followed by its components for each entity of the group
+   *
+   * @note The group is walked back to front, so components may be removed from the current entity. Entities that enter
+   * the group during the iteration are not visited
+   *
+   * @return
+   */
+  auto each() const noexcept -> iterable {
+    const auto owned = std::make_tuple(std::get<Owned*>(_containers)...);
+    const auto get = std::make_tuple(std::get<Get*>(_containers)...);
+
+    return iterable{
+      detail::group_iterator<type_list<Owned...>, type_list<Get...>>{begin(), static_cast<std::ptrdiff_t>(size()), owned, get},
+      detail::group_iterator<type_list<Owned...>, type_list<Get...>>{begin(), 0, owned, get}
+    };
+  }
+
+private:
+
+  basic_group(const size_type& length, Owned&... owned, Get&... get) noexcept
+  : _length{&length},
+    _containers{&owned..., &get...} { }
+
+  const size_type* _length;
+  container_storage_type _containers;
+
+}; // class basic_group
+
+} // namespace ecs
+
+#endif // LIBECS_GROUP_HPP_
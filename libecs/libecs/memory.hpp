@@ -1,6 +1,7 @@
 #ifndef LIBECS_MEMORY_HPP_
 #define LIBECS_MEMORY_HPP_
 
+#include <cstddef>
 #include <memory>
 #include <type_traits>
 
@@ -17,6 +18,19 @@ struct rebound_allocator {
 template<typename Allocator, typename Type>
 using rebound_allocator_t = rebound_allocator<Allocator, Type>::type;
 
+[[nodiscard]] inline constexpr auto is_power_of_two(const std::size_t value) noexcept -> bool {
+  return value && ((value & (value - 1u)) == 0u);
+}
+
+/** @brief Alignment that keeps data written by different threads on separate cache lines */
+inline constexpr auto cache_line_size_v = std::size_t{64u};
+
+template<std::size_t Mod>
+requires (is_power_of_two(Mod))
+[[nodiscard]] inline constexpr auto fast_mod(const std::size_t value) noexcept -> std::size_t {
+  return value & (Mod - 1u);
+}
+
 } // namespace ecs
 
 #endif // LIBECS_MEMORY_HPP_
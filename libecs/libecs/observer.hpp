@@ -0,0 +1,176 @@
+#ifndef LIBECS_OBSERVER_HPP_
+#define LIBECS_OBSERVER_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libecs/memory.hpp>
+#include <libecs/entity.hpp>
+#include <libecs/sparse_set.hpp>
+#include <libecs/type_list.hpp>
+#include <libecs/registry.hpp>
+
+namespace ecs {
+
+/**
+ * @brief Collects the entities that started to match a set of component types, or had one of the required components
+ * updated while matching, since the observer was last cleared
+ *
+ * @note Entities that already match when the observer is constructed are not collected. Updates are the ones the
+ * registry publishes, from add_component on an assigned component and from patch. Entities that stop matching are
+ * dropped again, including destroyed ones. The registry must outlive the observer
+ *
+ * @tparam Entity Type of the entities
+ * @tparam Allocator Allocator type of the registry
+ */
+template<typename Entity, allocator_for<Entity> Allocator = std::allocator<Entity>>
+class basic_observer {
+
+public:
+
+  using registry_type = basic_registry<Entity, Allocator>;
+  using entity_type = typename registry_type::entity_type;
+  using size_type = std::size_t;
+  using iterator = typename key_set<Entity, Allocator>::const_iterator;
+
+  /**
+   * @brief Constructs an observer and connects it to the lifecycle signals of the given component types
+   *
+   * @tparam Components Types of the components that must be assigned
+   * @tparam Exclude Types of the components that must not be assigned
+   *
+   * @param registry The registry to observe
+   */
+  template<typename... Components, typename... Exclude>
+  requires (sizeof...(Components) != 0)
+  basic_observer(registry_type& registry, get_t<Components...>, exclude_t<Exclude...> = exclude_t<Exclude...>{})
+  : _entities{},
+    _connections{} {
+    (_connect_required<Components, get_t<Components...>, exclude_t<Exclude...>>(registry), ...);
+    (_connect_excluded<Exclude, get_t<Components...>, exclude_t<Exclude...>>(registry), ...);
+  }
+
+  basic_observer(const basic_observer&) = delete;
+
+  basic_observer(basic_observer&&) = delete;
+
+  ~basic_observer() {
+    disconnect();
+  }
+
+  auto operator=(const basic_observer&) -> basic_observer& = delete;
+
+  auto operator=(basic_observer&&) -> basic_observer& = delete;
+
+  auto size() const noexcept -> size_type {
+    return _entities.size();
+  }
+
+  auto empty() const noexcept -> bool {
+    return _entities.size() == 0u;
+  }
+
+  auto contains(const entity_type& entity) const noexcept -> bool {
+    return _entities.contains(entity);
+  }
+
+  auto begin() const -> iterator {
+    return _entities.begin();
+  }
+
+  auto end() const -> iterator {
+    return _entities.end();
+  }
+
+  /**
+   * @brief Invokes a function for every collected entity. The entities are not cleared
+   *
+   * @note The function may add and remove components, but entities it makes match are only seen by the next call
+   *
+   * @param func Function that takes an entity
+   */
+  template<typename Func>
+  requires (std::is_invocable_v<Func&, const entity_type&>)
+  auto each(Func func) const -> void {
+    // [NOTE]: The function may modify the collected entities through the registry, so they are copied first
+    const auto entities = std::vector<entity_type>{_entities.begin(), _entities.end()};
+    std::ranges::for_each(entities, [this, &func](const auto& entity) {
+      if (_entities.contains(entity)) {
+        std::invoke(func, entity);
+      }
+    });
+  }
+
+  /**
+   * @brief Forgets all collected entities
+   */
+  auto clear() -> void {
+    _entities.clear();
+  }
+
+  /**
+   * @brief Disconnects the observer from the registry. It stops collecting entities but keeps the ones it has
+   */
+  auto disconnect() -> void {
+    for (auto& [sink, connection] : _connections) {
+      sink.disconnect(connection);
+    }
+
+    _connections.clear();
+  }
+
+private:
+
+  template<typename Ignore, typename... Components, typename... Exclude>
+  static auto _matches(const registry_type& registry, const entity_type& entity, get_t<Components...>, exclude_t<Exclude...>) -> bool {
+    // [NOTE]: Storages are asked instead of signatures, since removed components are still assigned while the signal is published
+    return (registry.template has_component<Components>(entity) && ...) && ((std::is_same_v<Exclude, Ignore> || !registry.template has_component<Exclude>(entity)) && ...);
+  }
+
+  template<typename Component, typename Get, typename Exclude>
+  auto _connect_required(registry_type& registry) -> void {
+    const auto enter = [this](registry_type& source, const entity_type entity) {
+      if (_matches<void>(source, entity, Get{}, Exclude{})) {
+        _entities.add(entity);
+      }
+    };
+
+    _connect(registry.template on_construct<Component>(), enter);
+    _connect(registry.template on_update<Component>(), enter);
+    _connect(registry.template on_destroy<Component>(), [this]([[maybe_unused]] registry_type& source, const entity_type entity) {
+      _entities.remove(entity);
+    });
+  }
+
+  template<typename Component, typename Get, typename Exclude>
+  auto _connect_excluded(registry_type& registry) -> void {
+    _connect(registry.template on_construct<Component>(), [this]([[maybe_unused]] registry_type& source, const entity_type entity) {
+      _entities.remove(entity);
+    });
+    _connect(registry.template on_destroy<Component>(), [this](registry_type& source, const entity_type entity) {
+      if (_matches<Component>(source, entity, Get{}, Exclude{})) {
+        _entities.add(entity);
+      }
+    });
+  }
+
+  template<typename Listener>
+  auto _connect(typename registry_type::sink_type sink, Listener listener) -> void {
+    const auto connection = sink.connect(std::move(listener));
+    _connections.emplace_back(sink, connection);
+  }
+
+  key_set<Entity, Allocator> _entities;
+  std::vector<std::pair<typename registry_type::sink_type, connection>> _connections;
+
+}; // class basic_observer
+
+using observer = basic_observer<entity>;
+
+} // namespace ecs
+
+#endif // LIBECS_OBSERVER_HPP_
@@ -0,0 +1,374 @@
+#ifndef LIBECS_PAGED_VECTOR_HPP_
+#define LIBECS_PAGED_VECTOR_HPP_
+
+#include <compare>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+#include <libecs/memory.hpp>
+
+namespace ecs {
+
+namespace detail {
+
+template<typename Pointer, typename Type>
+class paged_vector_iterator {
+
+  template<typename, typename>
+  friend class paged_vector_iterator;
+
+public:
+
+  using value_type = std::remove_const_t<Type>;
+  using pointer = Type*;
+  using reference = Type&;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::random_access_iterator_tag;
+  using iterator_concept = std::random_access_iterator_tag;
+
+  constexpr paged_vector_iterator() noexcept
+  : _pages{},
+    _page_size{},
+    _index{} { }
+
+  constexpr paged_vector_iterator(const Pointer* pages, const std::size_t page_size, const difference_type index) noexcept
+  : _pages{pages},
+    _page_size{page_size},
+    _index{index} { }
+
+  template<typename OtherPointer, typename OtherType>
+  requires (std::is_convertible_v<OtherType*, Type*>)
+  constexpr paged_vector_iterator(const paged_vector_iterator<OtherPointer, OtherType>& other) noexcept
+  : _pages{other._pages},
+    _page_size{other._page_size},
+    _index{other._index} { }
+
+  constexpr auto operator++() noexcept -> paged_vector_iterator& {
+    ++_index;
+    return *this;
+  }
+
+  constexpr auto operator++(int) noexcept -> paged_vector_iterator {
+    auto copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  constexpr auto operator--() noexcept -> paged_vector_iterator& {
+    --_index;
+    return *this;
+  }
+
+  constexpr auto operator--(int) noexcept -> paged_vector_iterator {
+    auto copy = *this;
+    --(*this);
+    return copy;
+  }
+
+  constexpr auto operator+=(const difference_type value) noexcept -> paged_vector_iterator& {
+    _index += value;
+    return *this;
+  }
+
+  constexpr auto operator-=(const difference_type value) noexcept -> paged_vector_iterator& {
+    _index -= value;
+    return *this;
+  }
+
+  [[nodiscard]] constexpr auto operator+(const difference_type value) const noexcept -> paged_vector_iterator {
+    auto copy = *this;
+    return (copy += value);
+  }
+
+  [[nodiscard]] friend constexpr auto operator+(const difference_type value, const paged_vector_iterator& iterator) noexcept -> paged_vector_iterator {
+    return iterator + value;
+  }
+
+  [[nodiscard]] constexpr auto operator-(const difference_type value) const noexcept -> paged_vector_iterator {
+    auto copy = *this;
+    return (copy -= value);
+  }
+
+  [[nodiscard]] constexpr auto operator-(const paged_vector_iterator& other) const noexcept -> difference_type {
+    return _index - other._index;
+  }
+
+  [[nodiscard]] constexpr auto operator[](const difference_type value) const noexcept -> reference {
+    return *(*this + value);
+  }
+
+  [[nodiscard]] constexpr auto operator->() const noexcept -> pointer {
+    const auto index = static_cast<std::size_t>(_index);
+    return std::to_address(_pages[index / _page_size]) + (index & (_page_size - 1u));
+  }
+
+  [[nodiscard]] constexpr auto operator*() const noexcept -> reference {
+    return *operator->();
+  }
+
+  [[nodiscard]] constexpr auto index() const noexcept -> difference_type {
+    return _index;
+  }
+
+  [[nodiscard]] friend constexpr auto operator==(const paged_vector_iterator& lhs, const paged_vector_iterator& rhs) noexcept -> bool {
+    return lhs._index == rhs._index;
+  }
+
+  [[nodiscard]] friend constexpr auto operator<=>(const paged_vector_iterator& lhs, const paged_vector_iterator& rhs) noexcept -> std::strong_ordering {
+    return lhs._index <=> rhs._index;
+  }
+
+private:
+
+  const Pointer* _pages;
+  std::size_t _page_size;
+  difference_type _index;
+
+}; // class paged_vector_iterator
+
+} // namespace detail
+
+/**
+ * @brief Sequence container that stores its elements in fixed-size pages. Pages are never moved, so growing the
+ * container does not invalidate references to its elements
+ *
+ * @tparam Type Type of the elements
+ * @tparam Allocator Allocator for the elements
+ * @tparam PageSize Number of elements per page. Must be a power of two
+ */
+template<typename Type, allocator_for<Type> Allocator = std::allocator<Type>, std::size_t PageSize = 1024u>
+requires (is_power_of_two(PageSize))
+class paged_vector {
+
+  using allocator_traits = std::allocator_traits<Allocator>;
+  using page_type = typename allocator_traits::pointer;
+  using page_storage_type = std::vector<page_type, rebound_allocator_t<Allocator, page_type>>;
+
+public:
+
+  using value_type = Type;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = detail::paged_vector_iterator<page_type, value_type>;
+  using const_iterator = detail::paged_vector_iterator<page_type, const value_type>;
+
+  inline static constexpr auto page_size_v = PageSize;
+
+  paged_vector() = default;
+
+  paged_vector(const paged_vector& other) = delete;
+
+  paged_vector(paged_vector&& other) noexcept
+  : _pages{std::move(other._pages)},
+    _size{std::exchange(other._size, 0u)} { }
+
+  ~paged_vector() {
+    clear();
+    _release_pages(0u);
+  }
+
+  auto operator=(const paged_vector& other) -> paged_vector& = delete;
+
+  auto operator=(paged_vector&& other) noexcept -> paged_vector& {
+    if (this != &other) {
+      clear();
+      _release_pages(0u);
+
+      _pages = std::move(other._pages);
+      _size = std::exchange(other._size, 0u);
+    }
+
+    return *this;
+  }
+
+  auto get_allocator() const noexcept -> allocator_type {
+    return allocator_type{_pages.get_allocator()};
+  }
+
+  auto size() const noexcept -> size_type {
+    return _size;
+  }
+
+  auto empty() const noexcept -> bool {
+    return _size == 0u;
+  }
+
+  auto capacity() const noexcept -> size_type {
+    return _pages.size() * PageSize;
+  }
+
+  auto reserve(const size_type capacity) -> void {
+    _assure_pages((capacity + PageSize - 1u) / PageSize);
+  }
+
+  auto shrink_to_fit() -> void {
+    _release_pages((_size + PageSize - 1u) / PageSize);
+    _pages.shrink_to_fit();
+  }
+
+  template<typename... Args>
+  auto emplace_back(Args&&... args) -> reference {
+    _assure_pages(_size / PageSize + 1u);
+
+    auto allocator = get_allocator();
+    auto* element = _address(_size);
+
+    allocator_traits::construct(allocator, element, std::forward<Args>(args)...);
+    ++_size;
+
+    return *element;
+  }
+
+  auto push_back(const value_type& value) -> void {
+    emplace_back(value);
+  }
+
+  auto push_back(value_type&& value) -> void {
+    emplace_back(std::move(value));
+  }
+
+  auto pop_back() -> void {
+    auto allocator = get_allocator();
+    allocator_traits::destroy(allocator, _address(--_size));
+  }
+
+  /**
+   * @brief Constructs an element in a slot whose element has been destroyed with destroy_at
+   *
+   * @param index Index of the slot
+   * @param args Arguments to construct the element from
+   *
+   * @return The new element
+   */
+  template<typename... Args>
+  auto construct_at(const size_type index, Args&&... args) -> reference {
+    auto allocator = get_allocator();
+    auto* element = _address(index);
+
+    allocator_traits::construct(allocator, element, std::forward<Args>(args)...);
+
+    return *element;
+  }
+
+  /**
+   * @brief Destroys an element but keeps its slot. The slot must be refilled with construct_at or dropped with
+   * discard_back before the container destroys its elements
+   *
+   * @param index Index of the slot
+   */
+  auto destroy_at(const size_type index) -> void {
+    auto allocator = get_allocator();
+    allocator_traits::destroy(allocator, _address(index));
+  }
+
+  /**
+   * @brief Drops slots from the back without destroying their elements. Only valid for slots whose elements have
+   * been destroyed with destroy_at
+   *
+   * @param count Number of slots to drop
+   */
+  auto discard_back(const size_type count) noexcept -> void {
+    _size -= count;
+  }
+
+  auto resize(const size_type size, const value_type& value) -> void {
+    reserve(size);
+
+    while (_size < size) {
+      emplace_back(value);
+    }
+
+    while (_size > size) {
+      pop_back();
+    }
+  }
+
+  auto clear() -> void {
+    while (_size != 0u) {
+      pop_back();
+    }
+  }
+
+  auto operator[](const size_type index) -> reference {
+    return *_address(index);
+  }
+
+  auto operator[](const size_type index) const -> const_reference {
+    return *_address(index);
+  }
+
+  auto back() -> reference {
+    return *_address(_size - 1u);
+  }
+
+  auto back() const -> const_reference {
+    return *_address(_size - 1u);
+  }
+
+  auto begin() -> iterator {
+    return iterator{_pages.data(), PageSize, 0};
+  }
+
+  auto begin() const -> const_iterator {
+    return const_iterator{_pages.data(), PageSize, 0};
+  }
+
+  auto cbegin() const -> const_iterator {
+    return begin();
+  }
+
+  auto end() -> iterator {
+    return iterator{_pages.data(), PageSize, static_cast<difference_type>(_size)};
+  }
+
+  auto end() const -> const_iterator {
+    return const_iterator{_pages.data(), PageSize, static_cast<difference_type>(_size)};
+  }
+
+  auto cend() const -> const_iterator {
+    return end();
+  }
+
+private:
+
+  auto _address(const size_type index) const noexcept -> pointer {
+    return std::to_address(_pages[index / PageSize]) + fast_mod<PageSize>(index);
+  }
+
+  auto _assure_pages(const size_type count) -> void {
+    auto allocator = get_allocator();
+
+    if (count > _pages.size()) {
+      _pages.reserve(count);
+    }
+
+    while (_pages.size() < count) {
+      _pages.push_back(allocator_traits::allocate(allocator, PageSize));
+    }
+  }
+
+  auto _release_pages(const size_type count) -> void {
+    auto allocator = get_allocator();
+
+    while (_pages.size() > count) {
+      allocator_traits::deallocate(allocator, _pages.back(), PageSize);
+      _pages.pop_back();
+    }
+  }
+
+  page_storage_type _pages;
+  size_type _size{0u};
+
+}; // class paged_vector
+
+} // namespace ecs
+
+#endif // LIBECS_PAGED_VECTOR_HPP_
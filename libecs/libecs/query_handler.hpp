@@ -0,0 +1,58 @@
+#ifndef LIBECS_QUERY_HANDLER_HPP_
+#define LIBECS_QUERY_HANDLER_HPP_
+
+#include <cstddef>
+
+namespace ecs {
+
+namespace detail {
+
+/**
+ * @brief Type erased part of a group or cached view that the registry notifies about structural changes
+ *
+ * @tparam Entity Type of the entities
+ */
+template<typename Entity>
+class basic_query_handler {
+
+public:
+
+  using entity_type = Entity;
+  using size_type = std::size_t;
+
+  virtual ~basic_query_handler() = default;
+
+  virtual auto clear() -> void = 0;
+
+  /**
+   * @brief Checks if the handler has to be notified about structural changes of a component type
+   *
+   * @param type Type id of the component
+   *
+   * @return true if the component type is required or excluded by the query
+   */
+  virtual auto observes(const size_type type) const noexcept -> bool = 0;
+
+  /**
+   * @brief Called after a component has been assigned to an entity
+   *
+   * @param type Type id of the component
+   * @param entity The entity the component has been assigned to
+   */
+  virtual auto on_construct(const size_type type, const entity_type& entity) -> void = 0;
+
+  /**
+   * @brief Called before a component is removed from an entity
+   *
+   * @param type Type id of the component
+   * @param entity The entity the component is removed from
+   */
+  virtual auto on_destroy(const size_type type, const entity_type& entity) -> void = 0;
+
+}; // class basic_query_handler
+
+} // namespace detail
+
+} // namespace ecs
+
+#endif // LIBECS_QUERY_HANDLER_HPP_
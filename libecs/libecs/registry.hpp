@@ -3,20 +3,29 @@
 
 #include <vector>
 #include <memory>
-#include <unordered_map>
-#include <unordered_set>
-#include <typeindex>
 #include <optional>
 #include <algorithm>
 #include <tuple>
 #include <ranges>
+#include <bit>
+#include <limits>
+#include <cinttypes>
+#include <iterator>
+#include <concepts>
+#include <stdexcept>
+#include <atomic>
 
 #include <libecs/memory.hpp>
 #include <libecs/entity.hpp>
 #include <libecs/sparse_set.hpp>
 #include <libecs/storage.hpp>
 #include <libecs/view.hpp>
+#include <libecs/query_handler.hpp>
+#include <libecs/group.hpp>
+#include <libecs/cached_view.hpp>
+#include <libecs/signal.hpp>
 #include <libecs/component_handle.hpp>
+#include <libecs/type_index.hpp>
 
 namespace ecs {
 
@@ -41,7 +50,7 @@ struct variadic_template_size {
 template<typename... Types>
 constexpr auto variadic_template_size_v = variadic_template_size<Types...>::value;
 
-template<typename Entity, typename EntityList, typename FreeList> 
+template<typename Entity, typename EntityList>
 class registry_iterator {
 
   using iterator_type = EntityList::const_iterator;
@@ -57,17 +66,18 @@ public:
   using difference_type = typename iterator_type::difference_type;
   using iterator_category = std::forward_iterator_tag;
 
-  registry_iterator(iterator_type current, iterator_type end, FreeList& free_entities)
+  registry_iterator(iterator_type current, iterator_type end, std::size_t index)
   : _current{current},
     _end{end},
-    _free_entities{std::addressof(free_entities)} {
+    _index{index} {
     while(_current != _end && !_is_valid()) {
       ++_current;
+      ++_index;
     }
   }
 
   auto operator++() noexcept -> registry_iterator& {
-    while(++_current != _end && !_is_valid()) {}
+    while(++_index, ++_current != _end && !_is_valid()) {}
     return *this;
   }
 
@@ -85,20 +95,21 @@ public:
     return *(operator->());
   }
 
-  template<typename LhsEntity, typename LhsEntityList, typename LhsFreeList, typename RhsEntity,  typename RhsEntityList, typename RhsFreeList>
-  friend auto operator==(const registry_iterator<LhsEntity, LhsEntityList, LhsFreeList>& lhs, const registry_iterator<RhsEntity, RhsEntityList, RhsFreeList>& rhs) noexcept -> bool {
+  template<typename LhsEntity, typename LhsEntityList, typename RhsEntity,  typename RhsEntityList>
+  friend auto operator==(const registry_iterator<LhsEntity, LhsEntityList>& lhs, const registry_iterator<RhsEntity, RhsEntityList>& rhs) noexcept -> bool {
     return lhs._current == rhs._current;
   } 
 
 private:
 
+  // [NOTE]: Destroyed slots store the id of the next free slot, so only alive slots carry their own id
   auto _is_valid() const noexcept -> bool {
-    return !_free_entities->contains(entity_traits::to_id(*_current));
+    return static_cast<std::size_t>(entity_traits::to_id(*_current)) == _index;
   }
 
   iterator_type _current;
   iterator_type _end;
-  const FreeList* _free_entities;
+  std::size_t _index;
 
 }; // class registry_iterator
 
@@ -110,21 +121,43 @@ class basic_registry {
   static_assert(allocator_for<Allocator, Entity>, "Invalid allocator type");
 
   using entity_storage_type = std::vector<Entity, Allocator>;
-  using free_list_type = std::unordered_set<std::size_t, std::hash<std::size_t>, std::equal_to<std::size_t>, rebound_allocator_t<Allocator, std::size_t>>;
 
   using basic_storage_type = sparse_set<Entity, Allocator>;
 
+  using signature_word_type = std::uint64_t;
+  using signature_storage_type = std::vector<signature_word_type, rebound_allocator_t<Allocator, signature_word_type>>;
+
+  inline static constexpr auto signature_word_bits_v = static_cast<std::size_t>(std::numeric_limits<signature_word_type>::digits);
+
   template<typename Type>
   using storage_type = constness_as_t<storage<Entity, std::remove_const_t<Type>, rebound_allocator_t<Allocator, std::remove_const_t<Type>>>, Type>;
 
   using entity_traits = ecs::entity_traits<Entity>;
 
+  using group_handler_type = detail::basic_group_handler<Entity>;
+  using query_handler_type = detail::basic_query_handler<Entity>;
+
+  using signal_type = signal<void(basic_registry&, const Entity)>;
+
+  struct component_signals {
+    signal_type construct;
+    signal_type update;
+    signal_type destroy;
+  }; // struct component_signals
+
+  struct tracked_storage {
+    basic_storage_type* storage;
+    auto (*set_tick)(basic_storage_type&, tick_type) noexcept -> void;
+  }; // struct tracked_storage
+
 public:
 
   using entity_type = entity_traits::entity_type;
+  using version_type = entity_traits::version_type;
   using allocator_type = Allocator;
   using size_type = std::size_t;
-  using iterator = registry_iterator<entity_type, entity_storage_type, free_list_type>;
+  using iterator = registry_iterator<entity_type, entity_storage_type>;
+  using sink_type = sink<void(basic_registry&, const entity_type)>;
 
   basic_registry() = default;
 
@@ -132,8 +165,17 @@ public:
 
   basic_registry(basic_registry&& other) noexcept
   : _entities{std::move(other._entities)},
-    _free_entities{std::move(other._free_entities)},
-    _storages{std::move(other._storages)} { }
+    _free_list{std::exchange(other._free_list, null_entity)},
+    _reserved{other._reserved.exchange(0u, std::memory_order_relaxed)},
+    _signatures{std::move(other._signatures)},
+    _signature_words{std::exchange(other._signature_words, 1u)},
+    _storages{std::move(other._storages)},
+    _groups{std::move(other._groups)},
+    _cached_views{std::move(other._cached_views)},
+    _observers{std::move(other._observers)},
+    _tracked{std::move(other._tracked)},
+    _tick{std::exchange(other._tick, tick_type{1})},
+    _signals{std::move(other._signals)} { }
 
   ~basic_registry() {
     clear();
@@ -144,36 +186,111 @@ public:
   auto operator=(basic_registry&& other) noexcept -> basic_registry& {
     if (this != &other) {
       _entities = std::move(other._entities);
-      _free_entities = std::move(other._free_entities);
+      _free_list = std::exchange(other._free_list, null_entity);
+      _reserved.store(other._reserved.exchange(0u, std::memory_order_relaxed), std::memory_order_relaxed);
+      _signatures = std::move(other._signatures);
+      _signature_words = std::exchange(other._signature_words, 1u);
       _storages = std::move(other._storages);
+      _groups = std::move(other._groups);
+      _cached_views = std::move(other._cached_views);
+      _observers = std::move(other._observers);
+      _tracked = std::move(other._tracked);
+      _tick = std::exchange(other._tick, tick_type{1});
+      _signals = std::move(other._signals);
     }
 
     return *this;
   }
 
   auto begin() -> iterator {
-    return iterator{_entities.begin(), _entities.end(), _free_entities};
+    return iterator{_entities.begin(), _entities.end(), 0u};
   }
 
   auto end() -> iterator {
-    return iterator{_entities.end(), _entities.end(), _free_entities};
+    return iterator{_entities.end(), _entities.end(), _entities.size()};
   }
 
   auto clear() -> void {
-    for (auto& [key, storage] : _storages) {
-      storage->clear();
+    for (auto& storage : _storages) {
+      if (storage) {
+        storage->clear();
+      }
+    }
+
+    for (auto& group : _groups) {
+      group->clear();
+    }
+
+    for (auto& cached_view : _cached_views) {
+      cached_view->clear();
     }
 
     _entities.clear();
-    _free_entities.clear();
+    _signatures.clear();
+    _free_list = null_entity;
+    _reserved.store(0u, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Reserves space for at least the given number of entities
+   *
+   * @param capacity
+   */
+  auto reserve_entities(const size_type capacity) -> void {
+    _entities.reserve(capacity);
+    _signatures.reserve(capacity * _signature_words);
+  }
+
+  /**
+   * @brief Reserves space for at least the given number of components in the storage of a component type
+   *
+   * @tparam Component Type of the component
+   * @param capacity
+   */
+  template<typename Component>
+  auto reserve(const size_type capacity) -> void {
+    _get_or_create_storage<std::remove_const_t<Component>>().reserve(capacity);
+  }
+
+  auto capacity() const noexcept -> size_type {
+    return _entities.capacity();
+  }
+
+  template<typename Component>
+  auto capacity() const -> size_type {
+    if (const auto storage = _try_get_storage<std::remove_const_t<Component>>(); storage) {
+      return storage->get().capacity();
+    }
+
+    return 0u;
+  }
+
+  /**
+   * @brief Releases unused capacity of the entity list and of all storages
+   */
+  auto shrink_to_fit() -> void {
+    for (auto& storage : _storages) {
+      if (storage) {
+        storage->shrink_to_fit();
+      }
+    }
+
+    _entities.shrink_to_fit();
+    _signatures.shrink_to_fit();
   }
 
   auto create_entity() -> entity_type {
-    if (!_free_entities.empty()) {
-      auto index = *_free_entities.begin();
-      _free_entities.erase(_free_entities.begin());
+    flush();
+
+    // [NOTE]: The free list is threaded through the destroyed slots. Each one stores the id of the next free slot and the version for its next use
+    if (_free_list != null_entity) {
+      const auto id = entity_traits::to_id(_free_list);
+      auto& slot = _entities[static_cast<std::size_t>(id)];
 
-      return _entities.at(index);
+      _free_list = entity_traits::construct(entity_traits::to_id(slot), entity_traits::to_version(null_entity));
+      slot = entity_traits::construct(id, entity_traits::to_version(slot));
+
+      return slot;
     }
 
     const auto id = static_cast<entity_traits::id_type>(_entities.size());
@@ -181,23 +298,130 @@ public:
     auto new_entity = entity_traits::construct(id);
 
     _entities.push_back(new_entity);
+    _signatures.resize(_signatures.size() + _signature_words, signature_word_type{0});
+
     return new_entity;
   }
 
+  /**
+   * @brief Creates multiple entities at once. Recycled ids are used first, the remaining entities are appended with a single reservation
+   *
+   * @param output Iterator to write the new entities to
+   * @param count Number of entities to create
+   *
+   * @return Iterator past the last written entity
+   */
+  template<std::output_iterator<entity_type> Iterator>
+  auto create_entities(Iterator output, size_type count) -> Iterator {
+    flush();
+
+    for (; count != 0u && _free_list != null_entity; --count) {
+      *output++ = create_entity();
+    }
+
+    const auto first_id = _entities.size();
+
+    _entities.reserve(first_id + count);
+    _signatures.resize(_signatures.size() + count * _signature_words, signature_word_type{0});
+
+    for (auto id = first_id; id < first_id + count; ++id) {
+      const auto new_entity = entity_traits::construct(static_cast<entity_traits::id_type>(id));
+
+      _entities.push_back(new_entity);
+      *output++ = new_entity;
+    }
+
+    return output;
+  }
+
+  /**
+   * @brief Reserves an entity without modifying the registry. Safe to call from multiple threads at once, as long as no
+   * other member function that modifies the registry runs concurrently
+   *
+   * @note Reserved entities always get a new id, destroyed ids are only recycled by create_entity. A reserved entity is
+   * not valid until the reservations are flushed and must not be used with the registry before that. Adding components
+   * to it throws std::invalid_argument, all other member functions treat it like a destroyed entity
+   *
+   * @return The reserved entity. It is unique and becomes valid at the next flush
+   */
+  auto reserve_entity() noexcept -> entity_type {
+    const auto id = _entities.size() + _reserved.fetch_add(1u, std::memory_order_relaxed);
+    return entity_traits::construct(static_cast<entity_traits::id_type>(id));
+  }
+
+  /**
+   * @brief Turns all entities reserved with reserve_entity into valid entities without components. Creating entities
+   * flushes the reservations first
+   */
+  auto flush() -> void {
+    if (const auto count = _reserved.load(std::memory_order_relaxed); count != 0u) {
+      const auto first_id = _entities.size();
+
+      _entities.reserve(first_id + count);
+      _signatures.resize(_signatures.size() + count * _signature_words, signature_word_type{0});
+
+      for (auto id = first_id; id < first_id + count; ++id) {
+        _entities.push_back(entity_traits::construct(static_cast<entity_traits::id_type>(id)));
+      }
+
+      _reserved.store(0u, std::memory_order_relaxed);
+    }
+  }
+
   auto destroy_entity(const entity_type& entity) -> void {
-    // [NOTE] : Clear out all components that are owned by this entity
-    for (auto& [type, storage] : _storages) {
-      storage->remove(entity);
+    if (!is_valid_entity(entity)) {
+      return;
     }
 
-    auto index = static_cast<std::size_t>(entity_traits::to_id(entity));
-    _free_entities.insert(index);
-    _entities.at(index) = entity_traits::next(_entities.at(index));
+    remove_all_components(entity);
+
+    const auto index = static_cast<std::size_t>(entity_traits::to_id(entity));
+    _entities[index] = entity_traits::construct(entity_traits::to_id(_free_list), entity_traits::to_version(entity_traits::next(entity)));
+    _free_list = entity_traits::construct(entity_traits::to_id(entity), entity_traits::to_version(null_entity));
   }
 
-  auto is_valid_entity(const entity_type& entity) -> bool {
-    auto index = static_cast<std::size_t>(entity._id());
-    return index < _entities.size() && entity == _entities.at(index);
+  /**
+   * @brief Destroys a range of entities. Invalid entities are skipped
+   *
+   * @note Bidirectional ranges are walked back to front, so a range over the entities of a storage stays valid while
+   * they are removed from it. The range is only copied first when a group, cached view or listener observes one of the
+   * component types assigned to its entities
+   *
+   * @param first Iterator to the first entity
+   * @param last Iterator past the last entity
+   */
+  template<std::forward_iterator Iterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, entity_type>)
+  auto destroy_entities(Iterator first, Iterator last) -> void {
+    if (_is_observed(first, last)) {
+      const auto entities = _copy_entities(first, last);
+      std::ranges::for_each(entities, [this](const auto entity){ destroy_entity(entity); });
+    } else if constexpr (std::bidirectional_iterator<Iterator>) {
+      while (first != last) {
+        destroy_entity(*--last);
+      }
+    } else {
+      for (; first != last; ++first) {
+        destroy_entity(*first);
+      }
+    }
+  }
+
+  auto is_valid_entity(const entity_type& entity) const -> bool {
+    const auto index = static_cast<std::size_t>(entity_traits::to_id(entity));
+    return index < _entities.size() && entity == _entities[index];
+  }
+
+  /**
+   * @brief Gets the current version of the id part of an entity
+   *
+   * @param entity
+   *
+   * @return The version that a valid entity with the same id has to carry
+   */
+  auto current(const entity_type& entity) const -> version_type {
+    const auto index = static_cast<std::size_t>(entity_traits::to_id(entity));
+    return index < _entities.size() ? entity_traits::to_version(_entities[index]) : entity_traits::to_version(null_entity);
   }
 
   template<typename Component>
@@ -209,11 +433,203 @@ public:
     return false;
   }
 
+  /**
+   * @brief Checks the component signature of an entity for all of the given component types
+   *
+   * @tparam Components Types of the components
+   * @param entity The entity to check
+   *
+   * @return true if the entity is valid and has all of the components assigned to it
+   */
+  template<typename... Components>
+  auto has_all(const entity_type& entity) const -> bool {
+    return is_valid_entity(entity) && (_has_signature_bit(entity, type_id<Components>()) && ...);
+  }
+
+  /**
+   * @brief Checks the component signature of an entity for any of the given component types
+   *
+   * @tparam Components Types of the components
+   * @param entity The entity to check
+   *
+   * @return true if the entity is valid and has at least one of the components assigned to it
+   */
+  template<typename... Components>
+  auto has_any(const entity_type& entity) const -> bool {
+    return is_valid_entity(entity) && (_has_signature_bit(entity, type_id<Components>()) || ...);
+  }
+
+  /**
+   * @brief Assigns a component to an entity or replaces the component that is already assigned to it
+   *
+   * @tparam Component Type of the component
+   * @param entity The entity to assign the component to
+   * @param args Arguments to construct the component from
+   *
+   * @throws std::invalid_argument when the entity is not valid, including reserved entities that have not been flushed
+   *
+   * @return The component assigned to the entity
+   */
   template<typename Component, typename... Args>
   auto add_component(const entity_type& entity, Args&&... args) -> component_handle<Component> {
+    // [NOTE]: A stale entity shares its slot with the entity that recycled it, so it must not touch the signature or the storage
+    if (!is_valid_entity(entity)) {
+      throw std::invalid_argument{"Entity is not valid"};
+    }
+
     auto& storage = _get_or_create_storage<std::remove_const_t<Component>>();
 
-    return storage.add(entity, std::forward<Args>(args)...);
+    if (!_is_observed(type_id<Component>())) {
+      _set_signature_bit(entity, type_id<Component>());
+      return storage.add(entity, std::forward<Args>(args)...);
+    }
+
+    if (storage.contains(entity)) {
+      storage.add(entity, std::forward<Args>(args)...);
+      _on_update(type_id<Component>(), entity);
+    } else {
+      storage.add(entity, std::forward<Args>(args)...);
+      _set_signature_bit(entity, type_id<Component>());
+      _on_construct(type_id<Component>(), entity);
+    }
+
+    // [NOTE]: Groups may have moved the new component, so it is looked up again
+    return *storage.try_get(entity);
+  }
+
+  /**
+   * @brief Assigns copies of a component to a range of entities
+   *
+   * @tparam Component Type of the component
+   * @param first Iterator to the first entity
+   * @param last Iterator past the last entity
+   * @param value The component to copy for each entity
+   *
+   * @throws std::invalid_argument when one of the entities is not valid, already has a component of the given type or
+   * is listed twice, no component is assigned in that case
+   */
+  template<typename Component, std::forward_iterator Iterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, entity_type>)
+  auto insert(Iterator first, Iterator last, const std::remove_const_t<Component>& value = {}) -> void {
+    _assure_valid_entities(first, last);
+
+    auto& storage = _get_or_create_storage<std::remove_const_t<Component>>();
+
+    storage.insert(first, last, value);
+
+    _set_signature_bits(first, last, type_id<Component>());
+
+    if (_is_observed(type_id<Component>())) {
+      for (const auto entity : _copy_entities(first, last)) {
+        _on_construct(type_id<Component>(), entity);
+      }
+    }
+  }
+
+  /**
+   * @brief Assigns components from a range to a range of entities
+   *
+   * @tparam Component Type of the component
+   * @param first Iterator to the first entity
+   * @param last Iterator past the last entity
+   * @param from Iterator to the component of the first entity
+   *
+   * @throws std::invalid_argument when one of the entities is not valid, already has a component of the given type or
+   * is listed twice, no component is assigned in that case
+   */
+  template<typename Component, std::forward_iterator Iterator, std::input_iterator ValueIterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, entity_type>)
+  auto insert(Iterator first, Iterator last, ValueIterator from) -> void {
+    _assure_valid_entities(first, last);
+
+    auto& storage = _get_or_create_storage<std::remove_const_t<Component>>();
+
+    storage.insert(first, last, from);
+
+    _set_signature_bits(first, last, type_id<Component>());
+
+    if (_is_observed(type_id<Component>())) {
+      for (const auto entity : _copy_entities(first, last)) {
+        _on_construct(type_id<Component>(), entity);
+      }
+    }
+  }
+
+  template<typename Component>
+  auto remove_component(const entity_type& entity) -> void {
+    if (!is_valid_entity(entity)) {
+      return;
+    }
+
+    if (auto storage = _try_get_storage<std::remove_const_t<Component>>(); storage && storage->get().contains(entity)) {
+      _on_destroy(type_id<Component>(), entity);
+      storage->get().remove(entity);
+      _reset_signature_bit(entity, type_id<Component>());
+    }
+  }
+
+  /**
+   * @brief Removes components from a range of entities. Entities that do not have a component are skipped
+   *
+   * @note With a single component type the storage removes the whole batch in one pass and is cleared wholesale when
+   * the range covers all of its entities. Once a group, cached view or listener observes one of the component types the
+   * range is copied first and the components are removed one by one, since they may modify the storages the range
+   * points into
+   *
+   * @tparam Components Types of the components
+   * @param first Iterator to the first entity
+   * @param last Iterator past the last entity
+   */
+  template<typename... Components, std::forward_iterator Iterator>
+  requires (variadic_template_size_v<Components...> != 0 && std::convertible_to<std::iter_reference_t<Iterator>, entity_type>)
+  auto remove_components(Iterator first, Iterator last) -> void {
+    if ((_is_observed(type_id<Components>()) || ...)) {
+      for (const auto entity : _copy_entities(first, last)) {
+        (remove_component<Components>(entity), ...);
+      }
+    } else if constexpr (variadic_template_size_v<Components...> == 1u) {
+      if (auto storage = _try_get_storage<std::remove_const_t<Components>...>(); storage) {
+        for (auto entry = first; entry != last; ++entry) {
+          if (is_valid_entity(*entry) && storage->get().contains(*entry)) {
+            _reset_signature_bit(*entry, type_id<Components...>());
+          }
+        }
+
+        storage->get().remove(first, last);
+      }
+    } else if constexpr (std::bidirectional_iterator<Iterator>) {
+      while (first != last) {
+        const auto entity = entity_type{*--last};
+        (remove_component<Components>(entity), ...);
+      }
+    } else {
+      for (; first != last; ++first) {
+        const auto entity = entity_type{*first};
+        (remove_component<Components>(entity), ...);
+      }
+    }
+  }
+
+  /**
+   * @brief Removes all components from an entity. Only the storages that are marked in the signature of the entity are visited
+   *
+   * @param entity The entity to remove the components from
+   */
+  auto remove_all_components(const entity_type& entity) -> void {
+    if (!is_valid_entity(entity)) {
+      return;
+    }
+
+    auto* signature = _signature(entity);
+
+    for (auto word = std::size_t{0}; word < _signature_words; ++word) {
+      for (auto bits = std::exchange(signature[word], signature_word_type{0}); bits; bits &= bits - 1u) {
+        const auto type = word * signature_word_bits_v + static_cast<std::size_t>(std::countr_zero(bits));
+
+        _on_destroy(type, entity);
+        _storages[type]->remove(entity);
+      }
+    }
   }
 
   /**
@@ -247,8 +663,8 @@ public:
   template<typename Component>
   auto try_get_component(const entity_type& entity) const -> component_handle<const Component> {
     if (const auto storage = _try_get_storage<std::remove_const_t<Component>>(); storage) {
-      if (auto entry = storage->get().find(entity); entry != storage->get().cend()) {
-        return *entry;
+      if (const auto component = storage->get().try_get(entity); component) {
+        return *component;
       }
     }
 
@@ -258,34 +674,339 @@ public:
   template<typename Component>
   auto try_get_component(const entity_type& entity) -> component_handle<Component> {
     if (auto storage = _try_get_storage<std::remove_const_t<Component>>(); storage) {
-      if (auto entry = storage->get().find(entity); entry != storage->get().end()) {
-        return *entry;
+      if (auto component = storage->get().try_get(entity); component) {
+        return *component;
       }
     }
 
     return component_handle<Component>{};
   }
 
-  template<typename... Components>
+  /**
+   * @brief Modifies the component assigned to an entity in place and marks it as changed
+   *
+   * @tparam Component Type of the component
+   * @param entity The entity the component is assigned to
+   * @param funcs Functions that take a reference to the component, invoked in order
+   *
+   * @throws std::runtime_error when the entity does not have a component of the given type assigned to itself
+   *
+   * @return The component assigned to the entity
+   */
+  template<typename Component, typename... Funcs>
+  auto patch(const entity_type& entity, Funcs&&... funcs) -> component_handle<Component> {
+    if (auto storage = _try_get_storage<std::remove_const_t<Component>>(); storage && storage->get().contains(entity)) {
+      storage->get().patch(entity, std::forward<Funcs>(funcs)...);
+      _on_update(type_id<Component>(), entity);
+      return *storage->get().try_get(entity);
+    }
+
+    throw std::runtime_error{"Entity does not have component assigned to it"};
+  }
+
+  /**
+   * @brief Gets the sink of the signal that is published after a component of the given type has been assigned to an
+   * entity. Listeners take the registry and the entity
+   *
+   * @tparam Component Type of the component
+   *
+   * @return
+   */
+  template<typename Component>
+  auto on_construct() -> sink_type {
+    return sink_type{_signals_of(type_id<std::remove_const_t<Component>>()).construct};
+  }
+
+  /**
+   * @brief Gets the sink of the signal that is published after a component of the given type has been replaced by
+   * add_component or modified by patch. Other mutable access does not publish it
+   *
+   * @tparam Component Type of the component
+   *
+   * @return
+   */
+  template<typename Component>
+  auto on_update() -> sink_type {
+    return sink_type{_signals_of(type_id<std::remove_const_t<Component>>()).update};
+  }
+
+  /**
+   * @brief Gets the sink of the signal that is published before a component of the given type is removed from an
+   * entity, including when the entity is destroyed. The component can still be read by the listeners
+   *
+   * @note Clearing the registry does not publish the signal
+   *
+   * @tparam Component Type of the component
+   *
+   * @return
+   */
+  template<typename Component>
+  auto on_destroy() -> sink_type {
+    return sink_type{_signals_of(type_id<std::remove_const_t<Component>>()).destroy};
+  }
+
+  /**
+   * @brief Gets the current tick. Components that are added or changed are stamped with it
+   *
+   * @return
+   */
+  auto tick() const noexcept -> tick_type {
+    return _tick;
+  }
+
+  /**
+   * @brief Starts a new tick. A system that remembers the tick before advancing sees every later change through the
+   * changed and added view filters
+   *
+   * @return The new tick
+   */
+  auto advance_tick() noexcept -> tick_type {
+    ++_tick;
+
+    for (auto& tracked : _tracked) {
+      tracked.set_tick(*tracked.storage, _tick);
+    }
+
+    return _tick;
+  }
+
+  /**
+   * @brief Creates a view over the entities that have all of the given components
+   *
+   * @tparam Components Types of the required components
+   * @tparam Exclude Types of the components that must not be assigned
+   * @tparam Optional Types of the components that are yielded as pointers and may be nullptr
+   *
+   * @return The view
+   */
+  template<typename... Components, typename... Exclude, typename... Optional>
   requires (variadic_template_size_v<Components...> != 0)
-  auto create_view() -> basic_view<storage_type<Components>...> {
-    return {_get_or_create_storage<std::remove_const_t<Components>>()...};
+  auto create_view(exclude_t<Exclude...> = exclude_t<Exclude...>{}, optional_t<Optional...> = optional_t<Optional...>{}) -> basic_view<get_t<storage_type<Components>...>, exclude_t<storage_type<const Exclude>...>, optional_t<storage_type<Optional>...>> {
+    return {_get_or_create_storage<std::remove_const_t<Components>>()..., _get_or_create_storage<std::remove_const_t<Exclude>>()..., _get_or_create_storage<std::remove_const_t<Optional>>()...};
   }
 
-  template<typename... Components>
+  template<typename... Components, typename... Optional>
+  requires (variadic_template_size_v<Components...> != 0)
+  auto create_view(optional_t<Optional...> optional) -> basic_view<get_t<storage_type<Components>...>, exclude_t<>, optional_t<storage_type<Optional>...>> {
+    return create_view<Components...>(exclude_t<>{}, optional);
+  }
+
+  template<typename... Components, typename... Exclude, typename... Optional>
+  requires (variadic_template_size_v<Components...> != 0)
+  auto create_view(exclude_t<Exclude...> = exclude_t<Exclude...>{}, optional_t<Optional...> = optional_t<Optional...>{}) const -> basic_view<get_t<storage_type<const Components>...>, exclude_t<storage_type<const Exclude>...>, optional_t<storage_type<const Optional>...>> {
+    return {_get_or_create_storage<std::remove_const_t<Components>>()..., _get_or_create_storage<std::remove_const_t<Exclude>>()..., _get_or_create_storage<std::remove_const_t<Optional>>()...};
+  }
+
+  template<typename... Components, typename... Optional>
   requires (variadic_template_size_v<Components...> != 0)
-  auto create_view() const -> basic_view<storage_type<const Components>...> {
-    return {_get_or_create_storage<std::remove_const_t<Components>>()...};
+  auto create_view(optional_t<Optional...> optional) const -> basic_view<get_t<storage_type<const Components>...>, exclude_t<>, optional_t<storage_type<const Optional>...>> {
+    return create_view<Components...>(exclude_t<>{}, optional);
+  }
+
+  /**
+   * @brief Gets a group that owns the storages of the given component types. The first call creates the group and
+   * packs the entities that already match it, later calls return the same group
+   *
+   * @note A storage can only be owned by one group. Groups are kept up to date by the registry, so owned storages
+   * must not be modified directly
+   *
+   * @tparam Owned Types of the owned components
+   * @tparam Get Types of the components that are required but not owned
+   * @tparam Exclude Types of the components that must not be assigned
+   *
+   * @throws std::logic_error when one of the owned storages is already owned by a different group
+   *
+   * @return The group
+   */
+  template<typename... Owned, typename... Get, typename... Exclude>
+  requires (variadic_template_size_v<Owned...> != 0)
+  auto group(get_t<Get...> = get_t<Get...>{}, exclude_t<Exclude...> = exclude_t<Exclude...>{}) -> basic_group<owned_t<storage_type<Owned>...>, get_t<storage_type<Get>...>, exclude_t<storage_type<const Exclude>...>> {
+    using handler_type = detail::group_handler<owned_t<storage_type<std::remove_const_t<Owned>>...>, get_t<storage_type<std::remove_const_t<Get>>...>, exclude_t<storage_type<std::remove_const_t<Exclude>>...>>;
+
+    const auto group = std::ranges::find_if(_groups, [](const auto& handler) { return dynamic_cast<const handler_type*>(handler.get()) != nullptr; });
+
+    if (group != _groups.end()) {
+      return {(*group)->length(), _get_or_create_storage<std::remove_const_t<Owned>>()..., _get_or_create_storage<std::remove_const_t<Get>>()...};
+    }
+
+    if (std::ranges::any_of(_groups, [](const auto& handler) { return (handler->owns(type_id<Owned>()) || ...); })) {
+      throw std::logic_error{"Storage is already owned by another group"};
+    }
+
+    auto& handler = *_groups.emplace_back(std::make_unique<handler_type>(
+      _get_or_create_storage<std::remove_const_t<Owned>>()...,
+      _get_or_create_storage<std::remove_const_t<Get>>()...,
+      _get_or_create_storage<std::remove_const_t<Exclude>>()...
+    ));
+
+    _observe(handler);
+
+    return {handler.length(), _get_or_create_storage<std::remove_const_t<Owned>>()..., _get_or_create_storage<std::remove_const_t<Get>>()...};
+  }
+
+  /**
+   * @brief Gets a cached view over the entities that have all of the given components and none of the excluded ones.
+   * The first call creates the view and collects the entities that already match it, later calls return the same view
+   *
+   * @note The registry keeps the matching entities up to date when components are added or removed. Storages are not
+   * reordered, so cached views can be combined with groups and with other cached views
+   *
+   * @tparam Components Types of the required components
+   * @tparam Exclude Types of the components that must not be assigned
+   *
+   * @return The cached view
+   */
+  template<typename... Components, typename... Exclude>
+  requires (variadic_template_size_v<Components...> != 0)
+  auto cached_view(exclude_t<Exclude...> = exclude_t<Exclude...>{}) -> basic_cached_view<get_t<storage_type<Components>...>, exclude_t<storage_type<const Exclude>...>> {
+    using handler_type = detail::cached_view_handler<get_t<storage_type<std::remove_const_t<Components>>...>, exclude_t<storage_type<std::remove_const_t<Exclude>>...>>;
+
+    auto found = std::ranges::find_if(_cached_views, [](const auto& handler) { return dynamic_cast<const handler_type*>(handler.get()) != nullptr; });
+
+    if (found == _cached_views.end()) {
+      found = _cached_views.insert(_cached_views.end(), std::make_unique<handler_type>(
+        _get_or_create_storage<std::remove_const_t<Components>>()...,
+        _get_or_create_storage<std::remove_const_t<Exclude>>()...
+      ));
+
+      _observe(**found);
+    }
+
+    return {static_cast<const handler_type&>(**found).entities(), _get_or_create_storage<std::remove_const_t<Components>>()...};
   }
 
 private:
 
+  // [NOTE]: Signals are kept behind pointers, since sinks refer to them while the table grows
+  auto _signals_of(const size_type type) -> component_signals& {
+    if (type >= _signals.size()) {
+      _signals.resize(type + 1u);
+    }
+
+    if (!_signals[type]) {
+      _signals[type] = std::make_unique<component_signals>();
+    }
+
+    return *_signals[type];
+  }
+
+  // [NOTE]: The storages of all types a handler observes exist before the handler is created, so their ids are below the number of storages
+  auto _observe(query_handler_type& handler) -> void {
+    _observers.resize(std::max(_observers.size(), _storages.size()));
+
+    for (auto type = size_type{0}; type < _storages.size(); ++type) {
+      if (handler.observes(type)) {
+        _observers[type].push_back(&handler);
+      }
+    }
+  }
+
+  // [NOTE]: Types without groups, cached views and listeners take the same paths as if none of them existed
+  auto _is_observed(const size_type type) const noexcept -> bool {
+    if (type < _observers.size() && !_observers[type].empty()) {
+      return true;
+    }
+
+    if (type >= _signals.size() || !_signals[type]) {
+      return false;
+    }
+
+    const auto& signals = *_signals[type];
+
+    return !signals.construct.empty() || !signals.update.empty() || !signals.destroy.empty();
+  }
+
+  auto _is_observed() const noexcept -> bool {
+    return std::ranges::any_of(_observers, [](const auto& observers) { return !observers.empty(); }) || std::ranges::any_of(_signals, [](const auto& signals) {
+      return signals && (!signals->construct.empty() || !signals->update.empty() || !signals->destroy.empty());
+    });
+  }
+
+  // [NOTE]: Destroying an entity only touches the types in its signature, so the signatures of the range are checked against the observed types
+  template<typename Iterator>
+  auto _is_observed(Iterator first, Iterator last) const -> bool {
+    if (!_is_observed()) {
+      return false;
+    }
+
+    auto observed = std::vector<signature_word_type>(_signature_words, signature_word_type{0});
+
+    for (auto type = size_type{0}; type < _signature_words * signature_word_bits_v; ++type) {
+      if (_is_observed(type)) {
+        observed[type / signature_word_bits_v] |= (signature_word_type{1} << (type % signature_word_bits_v));
+      }
+    }
+
+    return std::any_of(first, last, [this, &observed](const entity_type entity) {
+      if (!is_valid_entity(entity)) {
+        return false;
+      }
+
+      const auto* signature = _signature(entity);
+
+      for (auto word = std::size_t{0}; word < _signature_words; ++word) {
+        if (signature[word] & observed[word]) {
+          return true;
+        }
+      }
+
+      return false;
+    });
+  }
+
+  // [NOTE]: Groups, cached views and listeners are notified after a component has been added and before it is removed, while it is still assigned
+  auto _on_construct(const size_type type, const entity_type& entity) -> void {
+    if (type < _observers.size()) {
+      for (auto* handler : _observers[type]) {
+        handler->on_construct(type, entity);
+      }
+    }
+
+    if (type < _signals.size() && _signals[type]) {
+      _signals[type]->construct.publish(*this, entity);
+    }
+  }
+
+  auto _on_update(const size_type type, const entity_type& entity) -> void {
+    if (type < _signals.size() && _signals[type]) {
+      _signals[type]->update.publish(*this, entity);
+    }
+  }
+
+  auto _on_destroy(const size_type type, const entity_type& entity) -> void {
+    if (type < _signals.size() && _signals[type]) {
+      _signals[type]->destroy.publish(*this, entity);
+    }
+
+    if (type < _observers.size()) {
+      for (auto* handler : _observers[type]) {
+        handler->on_destroy(type, entity);
+      }
+    }
+  }
+
+  template<typename Iterator>
+  auto _copy_entities(Iterator first, Iterator last) const -> std::vector<entity_type> {
+    auto entities = std::vector<entity_type>{};
+
+    for (; first != last; ++first) {
+      entities.push_back(*first);
+    }
+
+    return entities;
+  }
+
+  // [NOTE]: Storages are indexed by the sequential type id of their component, which is also the bit of the component in the entity signatures
   template<typename Component>
-  auto _get_or_create_storage() const -> const storage_type<Component>& {
-    const auto type = std::type_index{typeid(Component)};
+  auto _storage_pointer() const noexcept -> basic_storage_type* {
+    const auto index = type_id<Component>();
+    return index < _storages.size() ? _storages[index].get() : nullptr;
+  }
 
-    if (auto entry = _storages.find(type); entry != _storages.cend()) {
-      return static_cast<const storage_type<Component>&>(*entry->second);
+  template<typename Component>
+  auto _get_or_create_storage() const -> const storage_type<Component>& {
+    if (const auto* storage = _storage_pointer<Component>(); storage) {
+      return static_cast<const storage_type<Component>&>(*storage);
     }
 
     // [Note]: We use an empty storage placeholder in const context until we find it in the available storages
@@ -296,23 +1017,36 @@ private:
 
   template<typename Component>
   auto _get_or_create_storage() -> storage_type<Component>& {
-    const auto type = std::type_index{typeid(Component)};
+    if (auto* storage = _storage_pointer<Component>(); storage) {
+      return static_cast<storage_type<Component>&>(*storage);
+    }
 
-    if (auto entry = _storages.find(type); entry != _storages.end()) {
-      return static_cast<storage_type<Component>&>(*entry->second);
+    const auto index = type_id<Component>();
+
+    if (index >= _storages.size()) {
+      _storages.resize(index + 1u);
     }
 
-    auto entry = _storages.insert({type, std::make_unique<storage_type<Component>>()}).first;
+    _storages[index] = std::make_unique<storage_type<Component>>();
+
+    _assure_signature_bit(index);
 
-    return static_cast<storage_type<Component>&>(*entry->second);
+    if constexpr (storage_type<Component>::track_changes_v) {
+      auto& storage = static_cast<storage_type<Component>&>(*_storages[index]);
+
+      storage.set_tick(_tick);
+      _tracked.push_back(tracked_storage{&storage, [](basic_storage_type& base, const tick_type tick) noexcept -> void {
+        static_cast<storage_type<Component>&>(base).set_tick(tick);
+      }});
+    }
+
+    return static_cast<storage_type<Component>&>(*_storages[index]);
   }
 
   template<typename Component>
   auto _try_get_storage() const -> std::optional<std::reference_wrapper<const storage_type<Component>>> {
-    const auto type = std::type_index{typeid(Component)};
-
-    if (auto entry = _storages.find(type); entry != _storages.cend()) {
-      return std::cref(static_cast<const storage_type<Component>&>(*entry->second));
+    if (const auto* storage = _storage_pointer<Component>(); storage) {
+      return std::cref(static_cast<const storage_type<Component>&>(*storage));
     }
 
     return std::nullopt;
@@ -320,19 +1054,82 @@ private:
 
   template<typename Component>
   auto _try_get_storage() -> std::optional<std::reference_wrapper<storage_type<Component>>> {
-    const auto type = std::type_index{typeid(Component)};
-
-    if (auto entry = _storages.find(type); entry != _storages.end()) {
-      return std::ref(static_cast<storage_type<Component>&>(*entry->second));
+    if (auto* storage = _storage_pointer<Component>(); storage) {
+      return std::ref(static_cast<storage_type<Component>&>(*storage));
     }
 
     return std::nullopt;
   }
 
+  template<typename Iterator>
+  auto _assure_valid_entities(Iterator first, Iterator last) const -> void {
+    if (!std::all_of(first, last, [this](const entity_type entity) { return is_valid_entity(entity); })) {
+      throw std::invalid_argument{"Entity is not valid"};
+    }
+  }
+
+  auto _signature(const entity_type& entity) -> signature_word_type* {
+    return _signatures.data() + static_cast<std::size_t>(entity_traits::to_id(entity)) * _signature_words;
+  }
+
+  auto _signature(const entity_type& entity) const -> const signature_word_type* {
+    return _signatures.data() + static_cast<std::size_t>(entity_traits::to_id(entity)) * _signature_words;
+  }
+
+  auto _has_signature_bit(const entity_type& entity, const size_type bit) const -> bool {
+    return bit / signature_word_bits_v < _signature_words && (_signature(entity)[bit / signature_word_bits_v] & (signature_word_type{1} << (bit % signature_word_bits_v)));
+  }
+
+  auto _set_signature_bit(const entity_type& entity, const size_type bit) -> void {
+    _signature(entity)[bit / signature_word_bits_v] |= (signature_word_type{1} << (bit % signature_word_bits_v));
+  }
+
+  template<typename Iterator>
+  auto _set_signature_bits(Iterator first, Iterator last, const size_type bit) -> void {
+    for (; first != last; ++first) {
+      _set_signature_bit(*first, bit);
+    }
+  }
+
+  auto _reset_signature_bit(const entity_type& entity, const size_type bit) -> void {
+    _signature(entity)[bit / signature_word_bits_v] &= ~(signature_word_type{1} << (bit % signature_word_bits_v));
+  }
+
+  // [NOTE]: Signatures are stored back to back with a fixed number of words per entity. Widening them is rare and only happens when a new storage is created
+  auto _assure_signature_bit(const size_type bit) -> void {
+    const auto words = bit / signature_word_bits_v + 1u;
+
+    if (words <= _signature_words) {
+      return;
+    }
+
+    auto signatures = signature_storage_type(_entities.size() * words, signature_word_type{0}, _signatures.get_allocator());
+
+    for (auto index = std::size_t{0}; index < _entities.size(); ++index) {
+      std::copy_n(_signatures.data() + index * _signature_words, _signature_words, signatures.data() + index * words);
+    }
+
+    _signatures = std::move(signatures);
+    _signature_words = words;
+  }
+
   entity_storage_type _entities;
-  free_list_type _free_entities;
+  entity_type _free_list{null_entity};
+  std::atomic<size_type> _reserved{0u};
+
+  signature_storage_type _signatures;
+  size_type _signature_words{1u};
+
+  std::vector<std::unique_ptr<basic_storage_type>> _storages;
+
+  std::vector<std::unique_ptr<group_handler_type>> _groups;
+  std::vector<std::unique_ptr<query_handler_type>> _cached_views;
+  std::vector<std::vector<query_handler_type*>> _observers;
+
+  std::vector<tracked_storage> _tracked;
+  tick_type _tick{1u};
 
-  std::unordered_map<std::type_index, std::unique_ptr<basic_storage_type>> _storages;
+  std::vector<std::unique_ptr<component_signals>> _signals;
 
 }; // class basic_registry
 
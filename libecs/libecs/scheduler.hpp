@@ -0,0 +1,213 @@
+#ifndef LIBECS_SCHEDULER_HPP_
+#define LIBECS_SCHEDULER_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libecs/memory.hpp>
+#include <libecs/type_list.hpp>
+#include <libecs/type_index.hpp>
+#include <libecs/registry.hpp>
+#include <libecs/task_graph.hpp>
+#include <libecs/executor.hpp>
+
+namespace ecs {
+
+/**
+ * @brief Runs systems on an executor and orders them by the components they access. Systems that only read a
+ * component run concurrently, a system that writes a component runs after all systems registered before it that read
+ * or write the component, and before all systems registered after it that do
+ *
+ * @note Systems must not create or destroy entities or add or remove components, since that modifies storages other
+ * systems may iterate at the same time. Structural changes belong in exclusive systems
+ *
+ * @tparam Entity Type of the entities
+ * @tparam Allocator Allocator type of the registry
+ */
+template<typename Entity, allocator_for<Entity> Allocator = std::allocator<Entity>>
+class basic_scheduler {
+
+  struct access {
+    task writer;
+    std::vector<task> readers;
+  }; // struct access
+
+public:
+
+  using registry_type = basic_registry<Entity, Allocator>;
+  using size_type = std::size_t;
+
+  explicit basic_scheduler(registry_type& registry)
+  : _registry{&registry},
+    _flow{},
+    _accesses{},
+    _systems{},
+    _barrier{} { }
+
+  basic_scheduler(const basic_scheduler&) = delete;
+
+  basic_scheduler(basic_scheduler&&) = delete;
+
+  ~basic_scheduler() = default;
+
+  auto operator=(const basic_scheduler&) -> basic_scheduler& = delete;
+
+  auto operator=(basic_scheduler&&) -> basic_scheduler& = delete;
+
+  auto size() const noexcept -> size_type {
+    return _flow.size();
+  }
+
+  /**
+   * @brief Adds a system that iterates a view. Const components are read, all others are written. Excluded components
+   * are read
+   *
+   * @note The storages of the components are created here, so running the system never modifies the registry itself
+   *
+   * @tparam Components Types of the components of the view
+   * @tparam Exclude Types of the components that must not be assigned
+   *
+   * @param func Function that takes the view, or a function that is passed to view.each
+   *
+   * @return The task of the system. It can be ordered against other systems by hand
+   */
+  template<typename... Components, typename... Exclude, typename Func>
+  requires (variadic_template_size_v<Components...> != 0)
+  auto add_system(Func func, exclude_t<Exclude...> = exclude_t<Exclude...>{}) -> task {
+    using view_type = decltype(std::declval<registry_type&>().template create_view<Components...>(exclude_t<Exclude...>{}));
+
+    [[maybe_unused]] const auto view = _registry->template create_view<Components...>(exclude_t<Exclude...>{});
+
+    auto system = _flow.emplace([registry = _registry, func = std::move(func)]() mutable {
+      // [NOTE]: The view is created on every run, so its pivot is the smallest storage at that time
+      auto view = registry->template create_view<Components...>(exclude_t<Exclude...>{});
+
+      if constexpr (std::is_invocable_v<Func&, view_type&>) {
+        std::invoke(func, view);
+      } else {
+        view.each(func);
+      }
+    });
+
+    _depend(_barrier, system);
+
+    (_read(system, type_id<std::remove_const_t<Exclude>>()), ...);
+    ((std::is_const_v<Components> ? _read(system, type_id<std::remove_const_t<Components>>()) : _write(system, type_id<std::remove_const_t<Components>>())), ...);
+
+    _systems.push_back(system);
+
+    return system;
+  }
+
+  /**
+   * @brief Adds a system that has access to the whole registry. It runs after all systems that were added before it
+   * and before all systems that are added after it
+   *
+   * @param func Function that takes the registry
+   *
+   * @return The task of the system
+   */
+  template<typename Func>
+  requires (std::is_invocable_v<Func&, registry_type&>)
+  auto add_exclusive_system(Func func) -> task {
+    auto system = _flow.emplace([registry = _registry, func = std::move(func)]() mutable { std::invoke(func, *registry); });
+
+    if (_systems.empty()) {
+      _depend(_barrier, system);
+    }
+
+    for (auto& other : _systems) {
+      _depend(other, system);
+    }
+
+    _accesses.clear();
+    _systems.clear();
+    _barrier = system;
+
+    return system;
+  }
+
+  /**
+   * @brief Runs all systems once
+   *
+   * @param executor The executor that runs the systems
+   *
+   * @return A future that becomes ready when all systems have completed
+   */
+  auto run(executor& executor) -> std::future<void> {
+    return executor.run(_flow);
+  }
+
+  /**
+   * @brief Gets the task flow of the systems. It can be run any number of times
+   *
+   * @return
+   */
+  auto flow() noexcept -> task_flow& {
+    return _flow;
+  }
+
+private:
+
+  auto _read(task& system, const size_type type) -> void {
+    auto& access = _access(type);
+
+    _depend(access.writer, system);
+    access.readers.push_back(system);
+  }
+
+  auto _write(task& system, const size_type type) -> void {
+    auto& access = _access(type);
+
+    _depend(access.writer, system);
+
+    for (auto& reader : access.readers) {
+      _depend(reader, system);
+    }
+
+    access.readers.clear();
+    access.writer = system;
+  }
+
+  // [NOTE]: Accesses are indexed by the sequential type id of the component, like the storages of the registry
+  auto _access(const size_type type) -> access& {
+    if (type >= _accesses.size()) {
+      _accesses.resize(type + 1u);
+    }
+
+    return _accesses[type];
+  }
+
+  static auto _depend(task& first, task& second) -> void {
+    if (first.is_empty() || first == second) {
+      return;
+    }
+
+    auto found = false;
+
+    first.for_each_successor([&second, &found](const task successor) { found = found || successor == second; });
+
+    if (!found) {
+      first.precede(second);
+    }
+  }
+
+  registry_type* _registry;
+  task_flow _flow;
+
+  std::vector<access> _accesses;
+  std::vector<task> _systems;
+  task _barrier;
+
+}; // class basic_scheduler
+
+using scheduler = basic_scheduler<entity>;
+
+} // namespace ecs
+
+#endif // LIBECS_SCHEDULER_HPP_
@@ -0,0 +1,151 @@
+#ifndef LIBECS_SIGNAL_HPP_
+#define LIBECS_SIGNAL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <concepts>
+#include <utility>
+#include <vector>
+
+#include <libecs/delegate.hpp>
+
+namespace ecs {
+
+/**
+ * @brief Identifies a listener that has been connected to a signal
+ */
+class connection {
+
+  template<typename>
+  friend class signal;
+
+public:
+
+  connection() noexcept
+  : _id{0u} { }
+
+  auto is_valid() const noexcept -> bool {
+    return _id != 0u;
+  }
+
+  friend auto operator==(const connection& lhs, const connection& rhs) noexcept -> bool {
+    return lhs._id == rhs._id;
+  }
+
+private:
+
+  explicit connection(const std::size_t id) noexcept
+  : _id{id} { }
+
+  std::size_t _id;
+
+}; // class connection
+
+template<typename Signature>
+class signal;
+
+/**
+ * @brief List of delegates that are invoked in the order they were connected
+ *
+ * @note Listeners must not connect to or disconnect from the signal that is currently publishing
+ *
+ * @tparam Args Argument types of the listeners
+ */
+template<typename... Args>
+class signal<void(Args...)> {
+
+public:
+
+  using delegate_type = delegate<void(Args...)>;
+  using size_type = std::size_t;
+
+  signal() = default;
+
+  auto size() const noexcept -> size_type {
+    return _listeners.size();
+  }
+
+  auto empty() const noexcept -> bool {
+    return _listeners.empty();
+  }
+
+  /**
+   * @brief Connects a listener
+   *
+   * @param listener The delegate to invoke
+   *
+   * @return The connection of the listener, used to disconnect it
+   */
+  auto connect(delegate_type listener) -> connection {
+    const auto id = ++_last_id;
+    _listeners.emplace_back(id, std::move(listener));
+    return connection{id};
+  }
+
+  auto disconnect(const connection& connection) -> void {
+    std::erase_if(_listeners, [&connection](const auto& listener) { return listener.first == connection._id; });
+  }
+
+  auto clear() noexcept -> void {
+    _listeners.clear();
+  }
+
+  auto publish(Args... args) const -> void {
+    for (const auto& listener : _listeners) {
+      listener.second(args...);
+    }
+  }
+
+private:
+
+  std::vector<std::pair<size_type, delegate_type>> _listeners;
+  size_type _last_id{0u};
+
+}; // class signal
+
+/**
+ * @brief Restricted interface of a signal that only allows to connect and disconnect listeners
+ *
+ * @tparam Signature Signature of the listeners
+ */
+template<typename Signature>
+class sink {
+
+public:
+
+  using signal_type = signal<Signature>;
+  using delegate_type = typename signal_type::delegate_type;
+
+  explicit sink(signal_type& signal) noexcept
+  : _signal{&signal} { }
+
+  /**
+   * @brief Connects a listener
+   *
+   * @param args A callable or an instance and a member function, used to construct the delegate
+   *
+   * @return The connection of the listener
+   */
+  template<typename... Args>
+  requires (std::constructible_from<delegate_type, Args...>)
+  auto connect(Args&&... args) -> connection {
+    return _signal->connect(delegate_type{std::forward<Args>(args)...});
+  }
+
+  auto disconnect(const connection& connection) -> void {
+    _signal->disconnect(connection);
+  }
+
+  auto empty() const noexcept -> bool {
+    return _signal->empty();
+  }
+
+private:
+
+  signal_type* _signal;
+
+}; // class sink
+
+} // namespace ecs
+
+#endif // LIBECS_SIGNAL_HPP_
@@ -0,0 +1,302 @@
+#ifndef LIBECS_SOA_HPP_
+#define LIBECS_SOA_HPP_
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <libecs/component_traits.hpp>
+#include <libecs/component_handle.hpp>
+
+namespace ecs {
+
+template<typename Value, typename = typename component_traits<std::remove_const_t<Value>>::fields_type>
+class soa_reference;
+
+/**
+ * @brief Proxy for a component whose data members are stored in separate arrays. Reads and writes single members in
+ * place, converts to a copy of the whole component and assigns a whole component member by member
+ *
+ * @tparam Value Type of the component, const for read only access
+ * @tparam Members Pointers to the data members that are stored in separate arrays
+ */
+template<typename Value, auto... Members>
+class soa_reference<Value, fields_t<Members...>> {
+
+  using fields_type = fields_t<Members...>;
+
+  template<typename Type>
+  using constness_t = std::conditional_t<std::is_const_v<Value>, const Type, Type>;
+
+  using pointers_type = std::tuple<constness_t<detail::member_value_t<Members>>*...>;
+
+  template<typename, typename>
+  friend class soa_reference;
+
+  template<typename>
+  friend class soa_pointer;
+
+  template<typename>
+  friend class component_handle;
+
+public:
+
+  using value_type = std::remove_const_t<Value>;
+
+  explicit soa_reference(const pointers_type pointers) noexcept
+  : _pointers{pointers} { }
+
+  soa_reference(const soa_reference&) noexcept = default;
+
+  template<typename Other>
+  requires (std::is_const_v<Value> && std::is_same_v<Other, value_type>)
+  soa_reference(const soa_reference<Other, fields_type>& other) noexcept
+  : _pointers{other._pointers} { }
+
+  /**
+   * @brief Assigns the members of another component through the proxy
+   */
+  auto operator=(const soa_reference& other) const -> const soa_reference& requires (!std::is_const_v<Value>) {
+    return *this = static_cast<value_type>(other);
+  }
+
+  auto operator=(const value_type& value) const -> const soa_reference& requires (!std::is_const_v<Value>) {
+    ((get<Members>() = value.*Members), ...);
+    return *this;
+  }
+
+  /**
+   * @brief Gets a data member of the component
+   *
+   * @tparam Member Pointer to the data member
+   *
+   * @return
+   */
+  template<auto Member>
+  auto get() const noexcept -> constness_t<detail::member_value_t<Member>>& {
+    return *std::get<fields_type::template index_of<Member>>(_pointers);
+  }
+
+  template<std::size_t Index>
+  auto get() const noexcept -> decltype(auto) {
+    return *std::get<Index>(_pointers);
+  }
+
+  operator value_type() const {
+    auto value = value_type{};
+    ((value.*Members = get<Members>()), ...);
+    return value;
+  }
+
+private:
+
+  // [NOTE]: Null proxies only exist inside of empty pointers and handles, they are never handed out
+  soa_reference() noexcept
+  : _pointers{} { }
+
+  auto _is_null() const noexcept -> bool {
+    return std::get<0>(_pointers) == nullptr;
+  }
+
+  pointers_type _pointers;
+
+}; // class soa_reference
+
+/**
+ * @brief Pointer like wrapper of a proxy, returned where a storage of whole components returns a pointer
+ *
+ * @tparam Value Type of the component, const for read only access
+ */
+template<typename Value>
+class soa_pointer {
+
+public:
+
+  using reference = soa_reference<Value>;
+
+  soa_pointer() noexcept
+  : _reference{} { }
+
+  soa_pointer(std::nullptr_t) noexcept
+  : _reference{} { }
+
+  explicit soa_pointer(const reference reference) noexcept
+  : _reference{reference} { }
+
+  auto operator*() const noexcept -> reference {
+    return _reference;
+  }
+
+  auto operator->() const noexcept -> const reference* {
+    return std::addressof(_reference);
+  }
+
+  explicit operator bool() const noexcept {
+    return !_reference._is_null();
+  }
+
+private:
+
+  reference _reference;
+
+}; // class soa_pointer
+
+template<typename Value, typename = typename component_traits<std::remove_const_t<Value>>::fields_type>
+class soa_iterator;
+
+/**
+ * @brief Random access iterator over the components of a structure of arrays. Dereferencing yields a proxy
+ *
+ * @tparam Value Type of the component, const for read only access
+ * @tparam Members Pointers to the data members that are stored in separate arrays
+ */
+template<typename Value, auto... Members>
+class soa_iterator<Value, fields_t<Members...>> {
+
+  template<typename Type>
+  using constness_t = std::conditional_t<std::is_const_v<Value>, const Type, Type>;
+
+  using pointers_type = std::tuple<constness_t<detail::member_value_t<Members>>*...>;
+
+public:
+
+  using value_type = std::remove_const_t<Value>;
+  using reference = soa_reference<Value>;
+  using pointer = void;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::random_access_iterator_tag;
+
+  soa_iterator() noexcept
+  : _pointers{},
+    _index{0} { }
+
+  soa_iterator(const pointers_type pointers, const difference_type index) noexcept
+  : _pointers{pointers},
+    _index{index} { }
+
+  auto operator*() const noexcept -> reference {
+    return operator[](0);
+  }
+
+  auto operator[](const difference_type offset) const noexcept -> reference {
+    return reference{std::apply([index = _index + offset](auto*... field) { return pointers_type{field + index...}; }, _pointers)};
+  }
+
+  auto operator++() noexcept -> soa_iterator& {
+    ++_index;
+    return *this;
+  }
+
+  auto operator++(int) noexcept -> soa_iterator {
+    auto copy = *this;
+    ++_index;
+    return copy;
+  }
+
+  auto operator--() noexcept -> soa_iterator& {
+    --_index;
+    return *this;
+  }
+
+  auto operator--(int) noexcept -> soa_iterator {
+    auto copy = *this;
+    --_index;
+    return copy;
+  }
+
+  auto operator+=(const difference_type offset) noexcept -> soa_iterator& {
+    _index += offset;
+    return *this;
+  }
+
+  auto operator-=(const difference_type offset) noexcept -> soa_iterator& {
+    _index -= offset;
+    return *this;
+  }
+
+  friend auto operator+(soa_iterator iterator, const difference_type offset) noexcept -> soa_iterator {
+    return iterator += offset;
+  }
+
+  friend auto operator+(const difference_type offset, soa_iterator iterator) noexcept -> soa_iterator {
+    return iterator += offset;
+  }
+
+  friend auto operator-(soa_iterator iterator, const difference_type offset) noexcept -> soa_iterator {
+    return iterator -= offset;
+  }
+
+  friend auto operator-(const soa_iterator& lhs, const soa_iterator& rhs) noexcept -> difference_type {
+    return lhs._index - rhs._index;
+  }
+
+  friend auto operator==(const soa_iterator& lhs, const soa_iterator& rhs) noexcept -> bool {
+    return lhs._index == rhs._index;
+  }
+
+  friend auto operator<=>(const soa_iterator& lhs, const soa_iterator& rhs) noexcept -> std::strong_ordering {
+    return lhs._index <=> rhs._index;
+  }
+
+private:
+
+  pointers_type _pointers;
+  difference_type _index;
+
+}; // class soa_iterator
+
+/**
+ * @brief Handle to a component that is stored as a structure of arrays. Holds a proxy instead of a pointer
+ *
+ * @tparam Type Type of the component
+ */
+template<typename Type>
+requires (soa_component<std::remove_const_t<Type>>)
+class component_handle<Type> {
+
+public:
+
+  using value_type = Type;
+  using reference = soa_reference<Type>;
+  using pointer = const reference*;
+
+  component_handle() : _reference{} { }
+
+  component_handle(std::nullptr_t) : _reference{} { }
+
+  component_handle(const reference reference) : _reference{reference} { }
+
+  ~component_handle() = default;
+
+  auto operator->() const -> pointer {
+    return std::addressof(_reference);
+  }
+
+  auto operator*() const -> reference {
+    return _reference;
+  }
+
+  operator bool() const {
+    return !_reference._is_null();
+  }
+
+  auto value() const -> reference {
+    return _reference;
+  }
+
+  auto valid() const -> bool {
+    return !_reference._is_null();
+  }
+
+private:
+
+  reference _reference;
+
+}; // class component_handle
+
+} // namespace ecs
+
+#endif // LIBECS_SOA_HPP_
@@ -1,80 +1,307 @@
 #ifndef LIBECS_SPARSE_SET_HPP_
 #define LIBECS_SPARSE_SET_HPP_
 
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <cinttypes>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <vector>
-#include <unordered_map>
 #include <type_traits>
 
 #include <libecs/memory.hpp>
+#include <libecs/entity.hpp>
+#include <libecs/component_traits.hpp>
 
 namespace ecs {
 
+/** @brief Result of a versioned lookup in the sparse index */
+enum class sparse_state : std::uint8_t {
+  absent,
+  present,
+  stale
+}; // enum class sparse_state
+
+/** @brief Policy for removing values from the dense array of a sparse set */
+enum class deletion_policy : std::uint8_t {
+  /** @brief Moves the last value into the hole. Keeps the dense array packed */
+  swap_and_pop,
+  /** @brief Leaves a tombstone in the hole that is reused by the next insertion. Keeps all other values in place */
+  in_place
+}; // enum class deletion_policy
+
 template<typename Type, allocator_for<Type> Allocator = std::allocator<Type>>
 class sparse_set {
 
   using allocator_traits = std::allocator_traits<Allocator>;
 
+  using entity_traits = ecs::entity_traits<Type>;
+
   using dense_storage_type = std::vector<Type, Allocator>;
-  using sparse_storage_type = std::unordered_map<Type, std::size_t, std::hash<Type>, std::equal_to<Type>, rebound_allocator_t<Allocator, std::pair<const Type, std::size_t>>>;
+
+  using page_allocator_type = Allocator;
+  using page_allocator_traits = std::allocator_traits<page_allocator_type>;
+  using page_type = typename page_allocator_traits::pointer;
+  using sparse_storage_type = std::vector<page_type, rebound_allocator_t<Allocator, page_type>>;
 
 public:
 
   using size_type = std::size_t;
   using allocator_type = Allocator;
   using value_type = Type;
+  using version_type = typename entity_traits::version_type;
   using reference = value_type&;
   using const_reference = const value_type&;
   using iterator = dense_storage_type::iterator;
   using const_iterator = dense_storage_type::const_iterator;
 
-  sparse_set() = default;
+  /**
+   * @brief Constructs an empty sparse set
+   *
+   * @param page_size Number of entries per page of the sparse index. Must be a power of two. Storages pass the
+   * sparse_page_size_v of their component_traits
+   * @param policy Deletion policy of the dense array
+   *
+   * @throws std::invalid_argument when the page size is not a power of two
+   */
+  explicit sparse_set(const size_type page_size = basic_component_traits::sparse_page_size_v, const deletion_policy policy = deletion_policy::swap_and_pop)
+  : _dense{},
+    _sparse{},
+    _page_size{page_size},
+    _page_shift{static_cast<size_type>(std::countr_zero(page_size))},
+    _policy{policy},
+    _free_list{null_index_v} {
+    if (!is_power_of_two(page_size)) {
+      throw std::invalid_argument{"Sparse page size must be a power of two"};
+    }
+  }
 
   sparse_set(const sparse_set& other) = delete;
 
   sparse_set(sparse_set&& other) noexcept
   : _dense{std::move(other._dense)},
-    _sparse{std::move(other._sparse)} { }
+    _sparse{std::move(other._sparse)},
+    _page_size{other._page_size},
+    _page_shift{other._page_shift},
+    _policy{other._policy},
+    _free_list{std::exchange(other._free_list, null_index_v)} { }
 
   virtual ~sparse_set() {
     clear();
+    _release_sparse_pages();
   }
 
   auto operator=(const sparse_set& other) -> sparse_set& = delete;
 
   auto operator=(sparse_set&& other) noexcept -> sparse_set& {
     if (this != &other) {
+      _release_sparse_pages();
+
       _dense = std::move(other._dense);
       _sparse = std::move(other._sparse);
+      _page_size = other._page_size;
+      _page_shift = other._page_shift;
+      _policy = other._policy;
+      _free_list = std::exchange(other._free_list, null_index_v);
     }
 
     return *this;
   }
 
-  auto contains(const_reference value) const -> bool {
-    if (const auto entry = _sparse.find(value); entry != _sparse.cend()) {
-      const auto index = entry->second;
+  /**
+   * @brief Looks up the id part of a value and compares the version stored next to it
+   *
+   * @param value
+   *
+   * @return sparse_state::present when the value is in the set, sparse_state::stale when the id is in the set with a different version and sparse_state::absent otherwise
+   */
+  auto state(const_reference value) const noexcept -> sparse_state {
+    const auto* entry = _sparse_entry(value);
+
+    if (!entry || entity_traits::to_id(*entry) == entity_traits::id_mask_v) {
+      return sparse_state::absent;
+    }
+
+    return entity_traits::to_version(*entry) == entity_traits::to_version(value) ? sparse_state::present : sparse_state::stale;
+  }
+
+  /**
+   * @brief Checks if a value of the dense array marks a hole left by in place deletion
+   *
+   * @param value
+   *
+   * @return true if the value is a tombstone
+   */
+  static constexpr auto is_tombstone(const_reference value) noexcept -> bool {
+    return entity_traits::to_version(value) == entity_traits::to_version(null_v);
+  }
+
+  auto contains(const_reference value) const noexcept -> bool {
+    return state(value) == sparse_state::present;
+  }
 
-      return index < _dense.size() && _dense.at(index) == value;
+  /**
+   * @brief Gets the version that is stored in the set for the id part of a value
+   *
+   * @param value
+   *
+   * @return The stored version or the version part of the null entity when the id is not in the set
+   */
+  auto current(const_reference value) const noexcept -> version_type {
+    const auto* entry = _sparse_entry(value);
+
+    if (!entry || entity_traits::to_id(*entry) == entity_traits::id_mask_v) {
+      return entity_traits::to_version(null_v);
     }
 
-    return false;
+    return entity_traits::to_version(*entry);
   }
 
+  /**
+   * @brief Gets the size of the dense array. Includes tombstones left by in place deletion
+   *
+   * @return
+   */
   auto size() const noexcept -> size_type {
     return _dense.size();
   }
 
+  auto policy() const noexcept -> deletion_policy {
+    return _policy;
+  }
+
+  /**
+   * @brief Moves values from the back of the dense array into the holes left by in place deletion and drops all
+   * tombstones. Invalidates references to the moved values
+   */
+  auto compact() -> void {
+    auto live_end = _dense.size();
+    auto hole = size_type{0};
+
+    while (true) {
+      while (live_end != 0u && is_tombstone(_dense[live_end - 1u])) {
+        --live_end;
+      }
+
+      while (hole < live_end && !is_tombstone(_dense[hole])) {
+        ++hole;
+      }
+
+      if (hole >= live_end) {
+        break;
+      }
+
+      _relocate(--live_end, hole);
+    }
+
+    _truncate(live_end);
+    _free_list = null_index_v;
+  }
+
+  auto capacity() const noexcept -> size_type {
+    return _dense.capacity();
+  }
+
+  /**
+   * @brief Reserves space for at least the given number of values
+   *
+   * @param capacity
+   */
+  auto reserve(const size_type capacity) -> void {
+    _reserve(capacity);
+  }
+
+  /**
+   * @brief Releases unused capacity and all sparse pages that do not index any value
+   */
+  auto shrink_to_fit() -> void {
+    _shrink_to_fit();
+  }
+
+  auto page_size() const noexcept -> size_type {
+    return _page_size;
+  }
+
   auto at(size_type index) const -> const_reference {
     return _dense.at(index);
   }
 
+  /**
+   * @brief Gets the position of a value in the dense array
+   *
+   * @param value
+   *
+   * @throws std::out_of_range when the value is not in the set
+   *
+   * @return The index of the value
+   */
+  auto index(const_reference value) const -> size_type {
+    return _index(value);
+  }
+
+  /**
+   * @brief Swaps the positions of two values in the dense array
+   *
+   * @param lhs
+   * @param rhs
+   *
+   * @throws std::out_of_range when one of the values is not in the set
+   */
+  auto swap_elements(const_reference lhs, const_reference rhs) -> void {
+    if (const auto lhs_index = _index(lhs), rhs_index = _index(rhs); lhs_index != rhs_index) {
+      _swap_at(lhs_index, rhs_index);
+    }
+  }
+
   auto remove(const_reference value) -> void {
-    if (!contains(value)) {
-      return;
+    if (const auto index = _try_index(value); index) {
+      _erase(*index);
+    }
+  }
+
+  /**
+   * @brief Removes a range of values in a single pass. Values that are not in the set are skipped
+   *
+   * @note Ranges that point into the dense array of this set and bidirectional ranges are removed back to front, so
+   * they stay valid while elements are moved. If a range into the dense array covers the entire set, the set is
+   * cleared wholesale
+   *
+   * @param first Iterator to the first value
+   * @param last Iterator past the last value
+   *
+   * @return The number of removed values
+   */
+  template<std::input_iterator Iterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, value_type>)
+  auto remove(Iterator first, Iterator last) -> size_type {
+    if constexpr (std::contiguous_iterator<Iterator> && std::is_same_v<std::iter_value_t<Iterator>, value_type>) {
+      if (first != last && _is_dense_range(std::to_address(first), std::to_address(last))) {
+        return _remove_dense_range(static_cast<size_type>(std::to_address(first) - _dense.data()), static_cast<size_type>(std::to_address(last) - _dense.data()));
+      }
+    }
+
+    auto removed = size_type{0};
+
+    if constexpr (std::bidirectional_iterator<Iterator>) {
+      while (first != last) {
+        if (const auto index = _try_index(*--last); index) {
+          _erase(*index);
+          ++removed;
+        }
+      }
+    } else {
+      for (; first != last; ++first) {
+        if (const auto index = _try_index(*first); index) {
+          _erase(*index);
+          ++removed;
+        }
+      }
     }
 
-    _swap_and_pop(value);
+    return removed;
   }
 
   auto clear() -> void {
@@ -107,31 +334,164 @@ public:
 
 protected:
 
-  virtual auto _swap_and_pop(const_reference value) -> void {
-    const auto index = _sparse.at(value);
+  auto _erase(const size_type index) -> void {
+    if (_policy == deletion_policy::in_place) {
+      _in_place_pop(index);
+    } else {
+      _swap_and_pop(index);
+    }
+  }
+
+  virtual auto _swap_and_pop(const size_type index) -> void {
+    const auto value = _dense[index];
+    const auto last = _dense.back();
 
-    _sparse.at(_dense.back()) = index;
-    const auto& old_value = std::exchange(_dense.at(index), _dense.back());
+    _assure_sparse_entry(last) = _sparse_value(index, last);
+    _dense[index] = last;
+    _assure_sparse_entry(value) = null_v;
 
     _dense.pop_back();
-    _sparse.erase(old_value);
+  }
+
+  // [NOTE]: Tombstones store the index of the next hole in their id part, which threads the free list through the dense array
+  virtual auto _in_place_pop(const size_type index) -> void {
+    _assure_sparse_entry(_dense[index]) = null_v;
+    _dense[index] = _tombstone_value(_free_list);
+    _free_list = index;
+  }
+
+  virtual auto _relocate(const size_type from, const size_type to) -> void {
+    const auto value = _dense[from];
+
+    _assure_sparse_entry(value) = _sparse_value(to, value);
+    _dense[to] = value;
+    _dense[from] = null_v;
+  }
+
+  virtual auto _swap_at(const size_type lhs, const size_type rhs) -> void {
+    const auto lhs_value = _dense[lhs];
+    const auto rhs_value = _dense[rhs];
+
+    _assure_sparse_entry(lhs_value) = _sparse_value(rhs, lhs_value);
+    _assure_sparse_entry(rhs_value) = _sparse_value(lhs, rhs_value);
+
+    _dense[lhs] = rhs_value;
+    _dense[rhs] = lhs_value;
+  }
+
+  virtual auto _truncate(const size_type size) -> void {
+    _dense.resize(size);
+  }
+
+  virtual auto _reserve(const size_type capacity) -> void {
+    _dense.reserve(capacity);
+  }
+
+  virtual auto _shrink_to_fit() -> void {
+    _dense.shrink_to_fit();
+
+    auto used_pages = std::vector<bool>(_sparse.size(), false);
+
+    for (const auto value : _dense) {
+      if (!is_tombstone(value)) {
+        used_pages[_page(value)] = true;
+      }
+    }
+
+    auto page_allocator = page_allocator_type{_dense.get_allocator()};
+
+    for (auto page = size_type{0}; page < _sparse.size(); ++page) {
+      if (_sparse[page] && !used_pages[page]) {
+        page_allocator_traits::deallocate(page_allocator, _sparse[page], _page_size);
+        _sparse[page] = nullptr;
+      }
+    }
+
+    while (!_sparse.empty() && !_sparse.back()) {
+      _sparse.pop_back();
+    }
+
+    _sparse.shrink_to_fit();
   }
 
   virtual auto _clear() -> void {
+    for (const auto value : _dense) {
+      if (!is_tombstone(value)) {
+        _assure_sparse_entry(value) = null_v;
+      }
+    }
+
     _dense.clear();
-    _sparse.clear();
+    _free_list = null_index_v;
   }
 
-  auto _emplace(const_reference value) -> void {
+  /**
+   * @brief Emplaces a value into the first hole of the dense array or at its end
+   *
+   * @pre The value is not contained in the set
+   *
+   * @return The index of the value in the dense array
+   */
+  auto _emplace(const_reference value) -> size_type {
+    if (_free_list != null_index_v) {
+      const auto index = std::exchange(_free_list, _tombstone_next(_dense[_free_list]));
+
+      _assure_sparse_entry(value) = _sparse_value(index, value);
+      _dense[index] = value;
+
+      return index;
+    }
+
     const auto index = _dense.size();
 
-    _sparse.insert({value, index});
+    _assure_sparse_entry(value) = _sparse_value(index, value);
     _dense.push_back(value);
+
+    return index;
+  }
+
+  /**
+   * @brief Emplaces a range of values at the end of the dense array with a single reservation
+   *
+   * @throws std::invalid_argument when one of the values is already contained in the set or listed twice, no value is
+   * emplaced in that case
+   */
+  template<std::forward_iterator Iterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, value_type>)
+  auto _emplace_range(Iterator first, Iterator last) -> void {
+    _dense.reserve(_dense.size() + static_cast<size_type>(std::distance(first, last)));
+
+    for (auto entry = first; entry != last; ++entry) {
+      if (contains(*entry)) {
+        // [NOTE]: Derived classes have not added anything for the range yet, so only the dense array and the sparse index are rolled back
+        for (; first != entry; ++first) {
+          if (_policy == deletion_policy::in_place) {
+            sparse_set::_in_place_pop(_index(*first));
+          } else {
+            sparse_set::_swap_and_pop(_index(*first));
+          }
+        }
+
+        throw std::invalid_argument{"Set already contains value"};
+      }
+
+      _emplace(*entry);
+    }
+  }
+
+  auto _try_index(const_reference value) const noexcept -> std::optional<size_type> {
+    const auto* entry = _sparse_entry(value);
+
+    if (!entry || entity_traits::to_id(*entry) == entity_traits::id_mask_v || entity_traits::to_version(*entry) != entity_traits::to_version(value)) {
+      return std::nullopt;
+    }
+
+    return static_cast<size_type>(entity_traits::to_id(*entry));
   }
 
   auto _index(const_reference value) const -> size_type {
-    if (const auto entry = _sparse.find(value); entry != _sparse.cend()) {
-      return entry->second;
+    if (const auto index = _try_index(value); index) {
+      return *index;
     }
 
     throw std::out_of_range{"Set does not contain value"};
@@ -139,11 +499,127 @@ protected:
 
 private:
 
+  // [NOTE]: Sparse entries store the dense index in the id part and the version of the value in the version part
+  inline static constexpr auto null_v = entity_traits::construct(entity_traits::id_mask_v, entity_traits::version_mask_v);
+
+  inline static constexpr auto null_index_v = static_cast<size_type>(entity_traits::id_mask_v);
+
+  static constexpr auto _tombstone_value(const size_type next) noexcept -> value_type {
+    return entity_traits::construct(static_cast<typename entity_traits::id_type>(next), entity_traits::to_version(null_v));
+  }
+
+  static constexpr auto _tombstone_next(const_reference value) noexcept -> size_type {
+    return static_cast<size_type>(entity_traits::to_id(value));
+  }
+
+  auto _is_dense_range(const value_type* first, const value_type* last) const noexcept -> bool {
+    const auto less = std::less<const value_type*>{};
+    return !_dense.empty() && !less(first, _dense.data()) && !less(_dense.data() + _dense.size(), last);
+  }
+
+  auto _remove_dense_range(const size_type first, size_type last) -> size_type {
+    if (first == 0u && last == _dense.size()) {
+      const auto removed = static_cast<size_type>(std::count_if(_dense.cbegin(), _dense.cend(), [](const auto value){ return !is_tombstone(value); }));
+      _clear();
+      return removed;
+    }
+
+    auto removed = size_type{0};
+
+    // [NOTE]: Swap and pop only moves elements from behind the current position, so walking backwards keeps the range intact
+    for (auto index = last; index-- > first;) {
+      if (!is_tombstone(_dense[index])) {
+        _erase(index);
+        ++removed;
+      }
+    }
+
+    return removed;
+  }
+
+  static constexpr auto _sparse_value(const size_type index, const_reference value) noexcept -> value_type {
+    return entity_traits::construct(static_cast<typename entity_traits::id_type>(index), entity_traits::to_version(value));
+  }
+
+  auto _page(const_reference value) const noexcept -> size_type {
+    return static_cast<size_type>(entity_traits::to_id(value)) >> _page_shift;
+  }
+
+  auto _offset(const_reference value) const noexcept -> size_type {
+    return static_cast<size_type>(entity_traits::to_id(value)) & (_page_size - 1u);
+  }
+
+  auto _sparse_entry(const_reference value) const noexcept -> const value_type* {
+    const auto page = _page(value);
+    return (page < _sparse.size() && _sparse[page]) ? std::to_address(_sparse[page]) + _offset(value) : nullptr;
+  }
+
+  auto _assure_sparse_entry(const_reference value) -> value_type& {
+    const auto page = _page(value);
+
+    if (page >= _sparse.size()) {
+      _sparse.resize(page + 1u, nullptr);
+    }
+
+    if (!_sparse[page]) {
+      auto page_allocator = page_allocator_type{_dense.get_allocator()};
+      _sparse[page] = page_allocator_traits::allocate(page_allocator, _page_size);
+      std::uninitialized_fill_n(std::to_address(_sparse[page]), _page_size, null_v);
+    }
+
+    return std::to_address(_sparse[page])[_offset(value)];
+  }
+
+  auto _release_sparse_pages() -> void {
+    auto page_allocator = page_allocator_type{_dense.get_allocator()};
+
+    for (auto& page : _sparse) {
+      if (page) {
+        page_allocator_traits::deallocate(page_allocator, page, _page_size);
+        page = nullptr;
+      }
+    }
+
+    _sparse.clear();
+  }
+
   dense_storage_type _dense;
   sparse_storage_type _sparse;
+  size_type _page_size;
+  size_type _page_shift;
+  deletion_policy _policy;
+  size_type _free_list;
 
 }; // class sparse_set
 
+/**
+ * @brief Sparse set that only keeps keys. Unlike the storages that derive from sparse_set, keys are added directly
+ *
+ * @tparam Type Type of the keys
+ * @tparam Allocator Allocator type
+ */
+template<typename Type, allocator_for<Type> Allocator = std::allocator<Type>>
+class key_set final : public sparse_set<Type, Allocator> {
+
+  using base_type = sparse_set<Type, Allocator>;
+
+public:
+
+  using base_type::base_type;
+
+  /**
+   * @brief Adds a key if it is not in the set yet
+   *
+   * @param value The key
+   */
+  auto add(const Type& value) -> void {
+    if (!base_type::contains(value)) {
+      base_type::_emplace(value);
+    }
+  }
+
+}; // class key_set
+
 } // namespace ecs
 
 #endif // LIBECS_SPARSE_SET_HPP_
@@ -5,19 +5,64 @@
 #include <iostream>
 #include <limits>
 #include <vector>
+#include <iterator>
+#include <concepts>
+#include <memory>
+#include <tuple>
+#include <functional>
+#include <span>
+#include <stdexcept>
 
 #include <libecs/sparse_set.hpp>
 #include <libecs/memory.hpp>
+#include <libecs/component_traits.hpp>
+#include <libecs/paged_vector.hpp>
+#include <libecs/type_list.hpp>
+#include <libecs/soa.hpp>
 
 namespace ecs {
 
+namespace detail {
+
+template<typename Value, typename Allocator, std::size_t PageSize>
+struct storage_container {
+  using type = paged_vector<Value, Allocator, PageSize>;
+}; // struct storage_container
+
+template<typename Value, typename Allocator>
+struct storage_container<Value, Allocator, 0u> {
+  using type = std::vector<Value, Allocator>;
+}; // struct storage_container
+
+template<typename Value, typename Allocator, std::size_t PageSize>
+using storage_container_t = typename storage_container<Value, Allocator, PageSize>::type;
+
+struct component_ticks {
+  tick_type added;
+  tick_type changed;
+}; // struct component_ticks
+
+template<typename Allocator>
+struct tick_state {
+  std::vector<component_ticks, rebound_allocator_t<Allocator, component_ticks>> entries;
+  tick_type current{1u};
+}; // struct tick_state
+
+struct no_tick_state { }; // struct no_tick_state
+
+} // namespace detail
+
 template<typename Key, typename Value, allocator_for<Value> Allocator = std::allocator<Value>>
 class storage : public sparse_set<Key, typename std::allocator_traits<Allocator>::rebind_alloc<Key>> {
 
   using allocator_traits = std::allocator_traits<Allocator>;
 
+  inline static constexpr auto page_size_v = component_traits<Value>::page_size_v;
+  inline static constexpr auto in_place_delete_v = component_traits<Value>::in_place_delete_v;
 
-  using container_type = std::vector<Value, Allocator>;
+  static_assert(!in_place_delete_v || page_size_v != 0u, "In place deletion requires a paged storage");
+
+  using container_type = detail::storage_container_t<Value, Allocator, page_size_v>;
 
 public:
 
@@ -30,14 +75,17 @@ public:
   using iterator = container_type::iterator;
   using const_iterator = container_type::const_iterator;
 
+  inline static constexpr auto track_changes_v = component_traits<Value>::track_changes_v;
+
   storage()
-  : base_type{} { }
+  : base_type{component_traits<Value>::sparse_page_size_v, in_place_delete_v ? deletion_policy::in_place : deletion_policy::swap_and_pop} { }
 
   storage(const storage& other) = delete;
 
   storage(storage&& other) noexcept
   : base_type{std::move(other)},
-    _values{std::move(other._values)} { }
+    _values{std::move(other._values)},
+    _ticks{std::move(other._ticks)} { }
 
   ~storage() {
     base_type::clear();
@@ -49,6 +97,7 @@ public:
     if (this != &other) {
       base_type::operator=(std::move(other));
       _values = std::move(other._values);
+      _ticks = std::move(other._ticks);
     }
 
     return *this;
@@ -57,15 +106,73 @@ public:
   template<typename... Args>
   requires(std::constructible_from<Value, Args...>)
   auto add(const key_type& key, Args&&... args) -> reference {
-    if (auto entry = find(key); entry != end()) {
-      return (*entry = value_type{std::forward<Args>(args)...});
+    if (const auto index = base_type::_try_index(key); index) {
+      _mark_changed(*index);
+      return (_values[*index] = value_type{std::forward<Args>(args)...});
     }
 
-    base_type::_emplace(key);
+    return _construct(base_type::_emplace(key), std::forward<Args>(args)...);
+  }
 
-    _values.emplace_back(std::forward<Args>(args)...);
+  /**
+   * @brief Assigns copies of a value to a range of keys
+   *
+   * @param first Iterator to the first key
+   * @param last Iterator past the last key
+   * @param value The value to copy for each key
+   *
+   * @throws std::invalid_argument when one of the keys is already contained in the storage or listed twice, no value is
+   * assigned in that case
+   */
+  template<std::forward_iterator Iterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, key_type> && std::copy_constructible<Value>)
+  auto insert(Iterator first, Iterator last, const value_type& value = value_type{}) -> void {
+    _values.reserve(_values.size() + static_cast<std::size_t>(std::distance(first, last)));
+
+    if constexpr (in_place_delete_v) {
+      for (auto entry = first; entry != last; ++entry) {
+        _assure_insertable(first, entry);
+        _construct(base_type::_emplace(*entry), value);
+      }
+    } else {
+      base_type::_emplace_range(first, last);
+
+      _values.resize(base_type::size(), value);
+      _mark_added_back();
+    }
+  }
 
-    return _values.back();
+  /**
+   * @brief Assigns values from a range to a range of keys
+   *
+   * @param first Iterator to the first key
+   * @param last Iterator past the last key
+   * @param from Iterator to the value of the first key. Must be valid for as many elements as there are keys
+   *
+   * @throws std::invalid_argument when one of the keys is already contained in the storage or listed twice, no value is
+   * assigned in that case
+   */
+  template<std::forward_iterator Iterator, std::input_iterator ValueIterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, key_type> && std::constructible_from<Value, std::iter_reference_t<ValueIterator>>)
+  auto insert(Iterator first, Iterator last, ValueIterator from) -> void {
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+
+    _values.reserve(_values.size() + count);
+
+    if constexpr (in_place_delete_v) {
+      for (auto entry = first; entry != last; ++entry, ++from) {
+        _assure_insertable(first, entry);
+        _construct(base_type::_emplace(*entry), *from);
+      }
+    } else {
+      base_type::_emplace_range(first, last);
+
+      for (auto index = std::size_t{0}; index < count; ++index, ++from) {
+        _values.emplace_back(*from);
+      }
+
+      _mark_added_back();
+    }
   }
 
   auto begin() -> iterator {
@@ -93,9 +200,9 @@ public:
   }
 
   auto find(const key_type& key) -> iterator {
-    if (base_type::contains(key)) {
+    if (const auto index = base_type::_try_index(key); index) {
       auto entry = begin();
-      std::advance(entry, base_type::_index(key));
+      std::advance(entry, *index);
       return entry;
     }
 
@@ -103,17 +210,41 @@ public:
   }
 
   auto find(const key_type& key) const -> const_iterator {
-    if (base_type::contains(key)) {
+    if (const auto index = base_type::_try_index(key); index) {
       auto entry = cbegin();
-      std::advance(entry, base_type::_index(key));
+      std::advance(entry, *index);
       return entry;
     }
 
     return cend();
   }
 
+  /**
+   * @brief Gets a pointer to the value of a key
+   *
+   * @param key
+   *
+   * @return A pointer to the value or nullptr when the key is not in the storage
+   */
+  auto try_get(const key_type& key) -> value_type* {
+    if (const auto index = base_type::_try_index(key); index) {
+      _mark_changed(*index);
+      return std::addressof(_values[*index]);
+    }
+
+    return nullptr;
+  }
+
+  auto try_get(const key_type& key) const -> const value_type* {
+    if (const auto index = base_type::_try_index(key); index) {
+      return std::addressof(_values[*index]);
+    }
+
+    return nullptr;
+  }
+
   auto get(const key_type& key) -> reference {
-    return *find(key);
+    return *try_get(key);
   }
 
   auto get(const key_type& key) const -> const_reference {
@@ -121,37 +252,724 @@ public:
   }
 
   auto as_tuple(const key_type& key) -> std::tuple<reference> {
-    return std::forward_as_tuple(*find(key));
+    return std::forward_as_tuple(*try_get(key));
   }
 
   auto as_tuple(const key_type& key) const -> std::tuple<const_reference> {
     return std::forward_as_tuple(*find(key));
   }
 
+  /**
+   * @brief Modifies the value of a key in place and marks it as changed
+   *
+   * @param key
+   * @param funcs Functions that take a reference to the value, invoked in order
+   *
+   * @return The value
+   */
+  template<typename... Funcs>
+  requires (std::invocable<Funcs&, reference> && ...)
+  auto patch(const key_type& key, Funcs&&... funcs) -> reference {
+    auto& value = get(key);
+    (std::invoke(funcs, value), ...);
+    return value;
+  }
+
+  /**
+   * @brief Gets the tick that is written when a value is added or changed
+   *
+   * @return
+   */
+  auto tick() const noexcept -> tick_type requires (track_changes_v) {
+    return _ticks.current;
+  }
+
+  auto set_tick(const tick_type tick) noexcept -> void requires (track_changes_v) {
+    _ticks.current = tick;
+  }
+
+  /**
+   * @brief Gets the tick at which the value at a position of the dense array was added
+   *
+   * @param index Position in the dense array
+   *
+   * @return
+   */
+  auto added_at(const std::size_t index) const noexcept -> tick_type requires (track_changes_v) {
+    return _ticks.entries[index].added;
+  }
+
+  /**
+   * @brief Gets the tick at which the value at a position of the dense array was last changed. Adding a value counts
+   * as a change
+   *
+   * @param index Position in the dense array
+   *
+   * @return
+   */
+  auto changed_at(const std::size_t index) const noexcept -> tick_type requires (track_changes_v) {
+    return _ticks.entries[index].changed;
+  }
+
+  /**
+   * @brief Marks the value at a position of the dense array as changed. Used by views that hand out mutable references
+   * to the dense array directly
+   *
+   * @param index Position in the dense array
+   */
+  auto mark_changed_at(const std::size_t index) noexcept -> void {
+    _mark_changed(index);
+  }
+
 protected:
 
-  auto _swap_and_pop(const key_type& key) -> void override {
-    const auto index = base_type::_index(key);
+  auto _swap_and_pop(const std::size_t index) -> void override {
+    if (index + 1u != _values.size()) {
+      _values[index] = std::move(_values.back());
+    }
+
+    _values.pop_back();
 
+    if constexpr (track_changes_v) {
+      _ticks.entries[index] = _ticks.entries.back();
+      _ticks.entries.pop_back();
+    }
+
+    base_type::_swap_and_pop(index);
+  }
+
+  auto _in_place_pop(const std::size_t index) -> void override {
+    if constexpr (in_place_delete_v) {
+      _values.destroy_at(index);
+    }
+
+    base_type::_in_place_pop(index);
+  }
+
+  auto _relocate(const std::size_t from, const std::size_t to) -> void override {
+    if constexpr (in_place_delete_v) {
+      _values.construct_at(to, std::move(_values[from]));
+      _values.destroy_at(from);
+
+      if constexpr (track_changes_v) {
+        _ticks.entries[to] = _ticks.entries[from];
+      }
+    }
+
+    base_type::_relocate(from, to);
+  }
+
+  auto _swap_at(const std::size_t lhs, const std::size_t rhs) -> void override {
     using std::swap;
-    swap(_values.at(index), _values.back());
+    swap(_values[lhs], _values[rhs]);
 
-    _values.pop_back();
+    if constexpr (track_changes_v) {
+      swap(_ticks.entries[lhs], _ticks.entries[rhs]);
+    }
+
+    base_type::_swap_at(lhs, rhs);
+  }
+
+  auto _truncate(const std::size_t size) -> void override {
+    if constexpr (in_place_delete_v) {
+      _values.discard_back(_values.size() - size);
+
+      if constexpr (track_changes_v) {
+        _ticks.entries.resize(size);
+      }
+    }
+
+    base_type::_truncate(size);
+  }
+
+  auto _reserve(const std::size_t capacity) -> void override {
+    base_type::_reserve(capacity);
+    _values.reserve(capacity);
+
+    if constexpr (track_changes_v) {
+      _ticks.entries.reserve(capacity);
+    }
+  }
+
+  auto _shrink_to_fit() -> void override {
+    base_type::_shrink_to_fit();
+    _values.shrink_to_fit();
 
-    base_type::_swap_and_pop(key);
+    if constexpr (track_changes_v) {
+      _ticks.entries.shrink_to_fit();
+    }
   }
 
   auto _clear() -> void override {
+    if constexpr (in_place_delete_v) {
+      // [NOTE]: Holes left by in place deletion have already been destroyed
+      auto index = std::size_t{0};
+
+      for (auto entry = base_type::cbegin(); entry != base_type::cend(); ++entry, ++index) {
+        if (!base_type::is_tombstone(*entry)) {
+          _values.destroy_at(index);
+        }
+      }
+
+      _values.discard_back(_values.size());
+    } else {
+      _values.clear();
+    }
+
+    if constexpr (track_changes_v) {
+      _ticks.entries.clear();
+    }
+
     base_type::_clear();
-    _values.clear();
   }
 
 private:
 
+  // [NOTE]: The keys before the rejected one have been assigned their values already, so they are removed like any other key
+  template<typename Iterator>
+  auto _assure_insertable(Iterator first, Iterator entry) -> void {
+    if (base_type::contains(*entry)) {
+      base_type::remove(first, entry);
+      throw std::invalid_argument{"Set already contains value"};
+    }
+  }
+
+  template<typename... Args>
+  auto _construct(const std::size_t index, Args&&... args) -> reference {
+    if constexpr (in_place_delete_v) {
+      if (index != _values.size()) {
+        auto& value = _values.construct_at(index, std::forward<Args>(args)...);
+        _mark_added(index);
+        return value;
+      }
+    }
+
+    auto& value = _values.emplace_back(std::forward<Args>(args)...);
+    _mark_added_back();
+    return value;
+  }
+
+  auto _mark_added(const std::size_t index) noexcept -> void {
+    if constexpr (track_changes_v) {
+      _ticks.entries[index] = detail::component_ticks{_ticks.current, _ticks.current};
+    }
+  }
+
+  auto _mark_added_back() -> void {
+    if constexpr (track_changes_v) {
+      _ticks.entries.resize(_values.size(), detail::component_ticks{_ticks.current, _ticks.current});
+    }
+  }
+
+  auto _mark_changed([[maybe_unused]] const std::size_t index) noexcept -> void {
+    if constexpr (track_changes_v) {
+      _ticks.entries[index].changed = _ticks.current;
+    }
+  }
+
   container_type _values;
 
+  // [NOTE]: Ticks are kept in a contiguous array even for paged storages, they are never referenced from outside
+  [[no_unique_address]] std::conditional_t<track_changes_v, detail::tick_state<Allocator>, detail::no_tick_state> _ticks;
+
 }; // class storage
 
+/**
+ * @brief Storage for empty component types. Only keeps track of the keys, since all values of an empty type are
+ * interchangeable
+ *
+ * @tparam Key Type of the keys
+ * @tparam Value Empty type of the values
+ * @tparam Allocator Allocator type
+ */
+template<typename Key, typename Value, allocator_for<Value> Allocator>
+requires (std::is_empty_v<Value>)
+class storage<Key, Value, Allocator> : public sparse_set<Key, typename std::allocator_traits<Allocator>::rebind_alloc<Key>> {
+
+public:
+
+  using base_type = sparse_set<Key, rebound_allocator_t<Allocator, Key>>;
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  inline static constexpr auto track_changes_v = false;
+
+  storage()
+  : base_type{component_traits<Value>::sparse_page_size_v, component_traits<Value>::in_place_delete_v ? deletion_policy::in_place : deletion_policy::swap_and_pop} { }
+
+  storage(const storage& other) = delete;
+
+  storage(storage&& other) noexcept = default;
+
+  ~storage() = default;
+
+  auto operator=(const storage& other) -> storage& = delete;
+
+  auto operator=(storage&& other) noexcept -> storage& = default;
+
+  /**
+   * @brief Adds a key to the storage
+   *
+   * @return The instance of the empty type that is shared by all keys
+   */
+  template<typename... Args>
+  requires(std::constructible_from<Value, Args...>)
+  auto add(const key_type& key, [[maybe_unused]] Args&&... args) -> reference {
+    if (!base_type::contains(key)) {
+      base_type::_emplace(key);
+    }
+
+    return _instance();
+  }
+
+  /**
+   * @brief Adds a range of keys to the storage
+   *
+   * @throws std::invalid_argument when one of the keys is already contained in the storage or listed twice, no key is
+   * added in that case
+   */
+  template<std::forward_iterator Iterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, key_type>)
+  auto insert(Iterator first, Iterator last, [[maybe_unused]] const value_type& value = value_type{}) -> void {
+    base_type::_emplace_range(first, last);
+  }
+
+  template<std::forward_iterator Iterator, std::input_iterator ValueIterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, key_type>)
+  auto insert(Iterator first, Iterator last, [[maybe_unused]] ValueIterator from) -> void {
+    base_type::_emplace_range(first, last);
+  }
+
+  auto try_get(const key_type& key) -> value_type* {
+    return base_type::contains(key) ? std::addressof(_instance()) : nullptr;
+  }
+
+  auto try_get(const key_type& key) const -> const value_type* {
+    return base_type::contains(key) ? std::addressof(_instance()) : nullptr;
+  }
+
+  auto get([[maybe_unused]] const key_type& key) const -> value_type {
+    return value_type{};
+  }
+
+  auto as_tuple([[maybe_unused]] const key_type& key) const -> std::tuple<> {
+    return std::tuple<>{};
+  }
+
+  /**
+   * @brief Invokes functions on the instance of the empty type. Empty types have no state to change, so nothing is
+   * marked as changed
+   *
+   * @param key
+   * @param funcs Functions that take a reference to the value, invoked in order
+   *
+   * @return The instance of the empty type that is shared by all keys
+   */
+  template<typename... Funcs>
+  requires (std::invocable<Funcs&, reference> && ...)
+  auto patch([[maybe_unused]] const key_type& key, Funcs&&... funcs) -> reference {
+    (std::invoke(funcs, _instance()), ...);
+    return _instance();
+  }
+
+  auto mark_changed_at([[maybe_unused]] const std::size_t index) noexcept -> void { }
+
+private:
+
+  static auto _instance() noexcept -> reference {
+    static auto instance = value_type{};
+    return instance;
+  }
+
+}; // class storage<Key, Value, Allocator>
+
+/**
+ * @brief Storage for aggregate component types that keeps each registered data member in its own array. Values are
+ * handed out as proxies, the arrays of single members are exposed as spans in the order of the dense array
+ *
+ * @tparam Key Type of the keys
+ * @tparam Value Aggregate type of the values
+ * @tparam Allocator Allocator type
+ */
+template<typename Key, typename Value, allocator_for<Value> Allocator>
+requires (soa_component<Value>)
+class storage<Key, Value, Allocator> : public sparse_set<Key, typename std::allocator_traits<Allocator>::rebind_alloc<Key>> {
+
+  using fields_type = typename component_traits<Value>::fields_type;
+
+  static_assert(component_traits<Value>::page_size_v == 0u && !component_traits<Value>::in_place_delete_v, "Components stored as structure of arrays require a storage without pages");
+  static_assert(std::is_default_constructible_v<Value>, "Components stored as structure of arrays must be default constructible");
+  static_assert(std::is_aggregate_v<Value>, "Components stored as structure of arrays must be aggregates");
+  // [NOTE]: Data members that are not listed would be dropped when a component is stored and default constructed when it is read back
+  static_assert(fields_type::is_unique && fields_type::size == detail::aggregate_member_count_v<Value>, "Every data member of a component stored as structure of arrays has to be listed once in its fields_type");
+
+  template<std::size_t Index>
+  using field_t = std::tuple_element_t<Index, typename fields_type::value_types>;
+
+  template<typename Type>
+  using field_container_t = std::vector<Type, rebound_allocator_t<Allocator, Type>>;
+
+  template<typename>
+  struct field_containers;
+
+  template<typename... Types>
+  struct field_containers<std::tuple<Types...>> {
+    using type = std::tuple<field_container_t<Types>...>;
+  }; // struct field_containers
+
+  using container_type = typename field_containers<typename fields_type::value_types>::type;
+
+public:
+
+  using base_type = sparse_set<Key, rebound_allocator_t<Allocator, Key>>;
+  using key_type = Key;
+  using value_type = Value;
+  using reference = soa_reference<value_type>;
+  using const_reference = soa_reference<const value_type>;
+  using pointer = soa_pointer<value_type>;
+  using const_pointer = soa_pointer<const value_type>;
+
+  using iterator = soa_iterator<value_type>;
+  using const_iterator = soa_iterator<const value_type>;
+
+  inline static constexpr auto track_changes_v = component_traits<Value>::track_changes_v;
+
+  storage()
+  : base_type{component_traits<Value>::sparse_page_size_v, deletion_policy::swap_and_pop} { }
+
+  storage(const storage& other) = delete;
+
+  storage(storage&& other) noexcept
+  : base_type{std::move(other)},
+    _values{std::move(other._values)},
+    _ticks{std::move(other._ticks)} { }
+
+  ~storage() {
+    base_type::clear();
+  }
+
+  auto operator=(const storage& other) -> storage& = delete;
+
+  auto operator=(storage&& other) noexcept -> storage& {
+    if (this != &other) {
+      base_type::operator=(std::move(other));
+      _values = std::move(other._values);
+      _ticks = std::move(other._ticks);
+    }
+
+    return *this;
+  }
+
+  template<typename... Args>
+  requires(std::constructible_from<Value, Args...>)
+  auto add(const key_type& key, Args&&... args) -> reference {
+    if (const auto index = base_type::_try_index(key); index) {
+      _mark_changed(*index);
+      return (_at(*index) = value_type{std::forward<Args>(args)...});
+    }
+
+    // [NOTE]: The value is built in full first, so the arrays stay consistent if its constructor throws
+    const auto value = value_type{std::forward<Args>(args)...};
+
+    _push_back(value);
+
+    try {
+      base_type::_emplace(key);
+    } catch (...) {
+      _for_each_field([](auto& field, [[maybe_unused]] const auto member) { field.pop_back(); });
+      throw;
+    }
+
+    _mark_added_back();
+
+    return _at(base_type::size() - 1u);
+  }
+
+  /**
+   * @brief Assigns copies of a value to a range of keys
+   *
+   * @throws std::invalid_argument when one of the keys is already contained in the storage or listed twice, no value is
+   * assigned in that case
+   */
+  template<std::forward_iterator Iterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, key_type>)
+  auto insert(Iterator first, Iterator last, const value_type& value = value_type{}) -> void {
+    base_type::_emplace_range(first, last);
+
+    _for_each_field([size = base_type::size(), &value](auto& field, const auto member) { field.resize(size, value.*member); });
+    _mark_added_back();
+  }
+
+  /**
+   * @brief Assigns values from a range to a range of keys
+   *
+   * @throws std::invalid_argument when one of the keys is already contained in the storage or listed twice, no value is
+   * assigned in that case
+   */
+  template<std::forward_iterator Iterator, std::input_iterator ValueIterator>
+  requires (std::convertible_to<std::iter_reference_t<Iterator>, key_type> && std::constructible_from<Value, std::iter_reference_t<ValueIterator>>)
+  auto insert(Iterator first, Iterator last, ValueIterator from) -> void {
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+
+    _reserve(base_type::size() + count);
+
+    for (auto index = std::size_t{0}; index < count; ++index, ++from) {
+      _push_back(value_type{*from});
+    }
+
+    base_type::_emplace_range(first, last);
+    _mark_added_back();
+  }
+
+  auto begin() -> iterator {
+    return iterator{_data(), 0};
+  }
+
+  auto begin() const -> const_iterator {
+    return const_iterator{_data(), 0};
+  }
+
+  auto cbegin() const -> const_iterator {
+    return begin();
+  }
+
+  auto end() -> iterator {
+    return iterator{_data(), static_cast<std::ptrdiff_t>(base_type::size())};
+  }
+
+  auto end() const -> const_iterator {
+    return const_iterator{_data(), static_cast<std::ptrdiff_t>(base_type::size())};
+  }
+
+  auto cend() const -> const_iterator {
+    return end();
+  }
+
+  auto find(const key_type& key) -> iterator {
+    const auto index = base_type::_try_index(key);
+    return std::next(begin(), static_cast<std::ptrdiff_t>(index ? *index : base_type::size()));
+  }
+
+  auto find(const key_type& key) const -> const_iterator {
+    const auto index = base_type::_try_index(key);
+    return std::next(begin(), static_cast<std::ptrdiff_t>(index ? *index : base_type::size()));
+  }
+
+  /**
+   * @brief Gets the array of one data member of all values, in the order of the dense array
+   *
+   * @note Writing through the span does not mark values as changed
+   *
+   * @tparam Member Pointer to the data member
+   *
+   * @return
+   */
+  template<auto Member>
+  auto field() noexcept -> std::span<detail::member_value_t<Member>> {
+    return std::get<fields_type::template index_of<Member>>(_values);
+  }
+
+  template<auto Member>
+  auto field() const noexcept -> std::span<const detail::member_value_t<Member>> {
+    return std::get<fields_type::template index_of<Member>>(_values);
+  }
+
+  /**
+   * @brief Gets a proxy of the value of a key
+   *
+   * @param key
+   *
+   * @return A pointer like wrapper of the proxy that is empty when the key is not in the storage
+   */
+  auto try_get(const key_type& key) -> pointer {
+    if (const auto index = base_type::_try_index(key); index) {
+      _mark_changed(*index);
+      return pointer{_at(*index)};
+    }
+
+    return nullptr;
+  }
+
+  auto try_get(const key_type& key) const -> const_pointer {
+    if (const auto index = base_type::_try_index(key); index) {
+      return const_pointer{_at(*index)};
+    }
+
+    return nullptr;
+  }
+
+  auto get(const key_type& key) -> reference {
+    return *try_get(key);
+  }
+
+  auto get(const key_type& key) const -> const_reference {
+    return *try_get(key);
+  }
+
+  auto as_tuple(const key_type& key) -> std::tuple<reference> {
+    return std::make_tuple(get(key));
+  }
+
+  auto as_tuple(const key_type& key) const -> std::tuple<const_reference> {
+    return std::make_tuple(get(key));
+  }
+
+  /**
+   * @brief Modifies the value of a key in place and marks it as changed
+   *
+   * @param key
+   * @param funcs Functions that take a proxy of the value, invoked in order
+   *
+   * @return The proxy of the value
+   */
+  template<typename... Funcs>
+  requires (std::invocable<Funcs&, reference> && ...)
+  auto patch(const key_type& key, Funcs&&... funcs) -> reference {
+    const auto value = get(key);
+    (std::invoke(funcs, value), ...);
+    return value;
+  }
+
+  auto tick() const noexcept -> tick_type requires (track_changes_v) {
+    return _ticks.current;
+  }
+
+  auto set_tick(const tick_type tick) noexcept -> void requires (track_changes_v) {
+    _ticks.current = tick;
+  }
+
+  auto added_at(const std::size_t index) const noexcept -> tick_type requires (track_changes_v) {
+    return _ticks.entries[index].added;
+  }
+
+  auto changed_at(const std::size_t index) const noexcept -> tick_type requires (track_changes_v) {
+    return _ticks.entries[index].changed;
+  }
+
+  auto mark_changed_at(const std::size_t index) noexcept -> void {
+    _mark_changed(index);
+  }
+
+protected:
+
+  auto _swap_and_pop(const std::size_t index) -> void override {
+    _for_each_field([index](auto& field, [[maybe_unused]] const auto member) {
+      if (index + 1u != field.size()) {
+        field[index] = std::move(field.back());
+      }
+
+      field.pop_back();
+    });
+
+    if constexpr (track_changes_v) {
+      _ticks.entries[index] = _ticks.entries.back();
+      _ticks.entries.pop_back();
+    }
+
+    base_type::_swap_and_pop(index);
+  }
+
+  auto _swap_at(const std::size_t lhs, const std::size_t rhs) -> void override {
+    _for_each_field([lhs, rhs](auto& field, [[maybe_unused]] const auto member) {
+      using std::swap;
+      swap(field[lhs], field[rhs]);
+    });
+
+    if constexpr (track_changes_v) {
+      std::swap(_ticks.entries[lhs], _ticks.entries[rhs]);
+    }
+
+    base_type::_swap_at(lhs, rhs);
+  }
+
+  auto _reserve(const std::size_t capacity) -> void override {
+    base_type::_reserve(capacity);
+    _for_each_field([capacity](auto& field, [[maybe_unused]] const auto member) { field.reserve(capacity); });
+
+    if constexpr (track_changes_v) {
+      _ticks.entries.reserve(capacity);
+    }
+  }
+
+  auto _shrink_to_fit() -> void override {
+    base_type::_shrink_to_fit();
+    _for_each_field([](auto& field, [[maybe_unused]] const auto member) { field.shrink_to_fit(); });
+
+    if constexpr (track_changes_v) {
+      _ticks.entries.shrink_to_fit();
+    }
+  }
+
+  auto _clear() -> void override {
+    _for_each_field([](auto& field, [[maybe_unused]] const auto member) { field.clear(); });
+
+    if constexpr (track_changes_v) {
+      _ticks.entries.clear();
+    }
+
+    base_type::_clear();
+  }
+
+private:
+
+  template<typename Func>
+  auto _for_each_field(Func func) -> void {
+    _for_each_field(func, std::make_index_sequence<fields_type::size>{});
+  }
+
+  template<typename Func, std::size_t... Index>
+  auto _for_each_field(Func& func, std::index_sequence<Index...>) -> void {
+    (func(std::get<Index>(_values), std::get<Index>(fields_type::members)), ...);
+  }
+
+  auto _data() noexcept {
+    return std::apply([](auto&... field) { return std::make_tuple(field.data()...); }, _values);
+  }
+
+  auto _data() const noexcept {
+    return std::apply([](const auto&... field) { return std::make_tuple(field.data()...); }, _values);
+  }
+
+  auto _at(const std::size_t index) noexcept -> reference {
+    return begin()[static_cast<std::ptrdiff_t>(index)];
+  }
+
+  auto _at(const std::size_t index) const noexcept -> const_reference {
+    return begin()[static_cast<std::ptrdiff_t>(index)];
+  }
+
+  // [NOTE]: Fields that were appended before a later one throws are removed again, so all arrays keep the same size
+  auto _push_back(const value_type& value) -> void {
+    const auto size = base_type::size();
+
+    try {
+      _for_each_field([&value](auto& field, const auto member) { field.push_back(value.*member); });
+    } catch (...) {
+      _for_each_field([size](auto& field, [[maybe_unused]] const auto member) { field.erase(std::next(field.begin(), static_cast<std::ptrdiff_t>(std::min(field.size(), size))), field.end()); });
+      throw;
+    }
+  }
+
+  auto _mark_added_back() -> void {
+    if constexpr (track_changes_v) {
+      _ticks.entries.resize(base_type::size(), detail::component_ticks{_ticks.current, _ticks.current});
+    }
+  }
+
+  auto _mark_changed([[maybe_unused]] const std::size_t index) noexcept -> void {
+    if constexpr (track_changes_v) {
+      _ticks.entries[index].changed = _ticks.current;
+    }
+  }
+
+  container_type _values;
+
+  [[no_unique_address]] std::conditional_t<track_changes_v, detail::tick_state<Allocator>, detail::no_tick_state> _ticks;
+
+}; // class storage<Key, Value, Allocator>
+
 } // namespace ecs
 
 #endif // LIBECS_STORAGE_HPP_
@@ -0,0 +1,438 @@
+#ifndef LIBECS_TASK_GRAPH_HPP_
+#define LIBECS_TASK_GRAPH_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace ecs {
+
+class node;
+class subflow;
+class task_flow;
+class executor;
+
+/**
+ * @brief Tasks without arguments that return nothing
+ */
+template<typename Callable>
+inline constexpr auto is_fixed_task_v = requires(Callable& callable) { { std::invoke(callable) } -> std::same_as<void>; };
+
+/**
+ * @brief Tasks that build a subflow when they run. The subflow is joined before the task completes
+ */
+template<typename Callable>
+inline constexpr auto is_dynamic_task_v = std::is_invocable_v<Callable, subflow&>;
+
+/**
+ * @brief Tasks that return the index of the successor to run next. All other successors are skipped
+ */
+template<typename Callable>
+inline constexpr auto is_condition_task_v = std::is_invocable_r_v<int, Callable> && !is_fixed_task_v<Callable>;
+
+/**
+ * @brief Owns the nodes of a task graph
+ */
+class graph {
+
+  friend class node;
+  friend class task;
+  friend class flow_builder;
+  friend class task_flow;
+  friend class executor;
+
+public:
+
+  using size_type = std::size_t;
+
+  graph() = default;
+
+  graph(const graph&) = delete;
+
+  graph(graph&& other) noexcept;
+
+  ~graph();
+
+  auto operator=(const graph&) -> graph& = delete;
+
+  auto operator=(graph&& other) noexcept -> graph&;
+
+  auto is_empty() const noexcept -> bool {
+    return _nodes.empty();
+  }
+
+  auto size() const noexcept -> size_type {
+    return _nodes.size();
+  }
+
+  auto clear() -> void;
+
+private:
+
+  auto _erase(node* node) -> void;
+
+  template<typename... Args>
+  auto _emplace_back(Args&&... args) -> node*;
+
+  std::vector<std::unique_ptr<node>> _nodes;
+
+}; // class graph
+
+/**
+ * @brief Per run state of a task flow. Runs of the same task flow are queued and executed one after another
+ */
+class topology {
+
+  friend class node;
+  friend class task_flow;
+  friend class executor;
+
+public:
+
+  using size_type = std::size_t;
+
+  topology(task_flow& flow, std::function<bool()> predicate)
+  : _flow{&flow},
+    _predicate{std::move(predicate)} { }
+
+private:
+
+  task_flow* _flow;
+  std::function<bool()> _predicate;
+  std::promise<void> _promise;
+  std::atomic<size_type> _pending{0u};
+  std::mutex _mutex;
+  std::exception_ptr _exception;
+  std::atomic<bool> _cancelled{false};
+
+}; // class topology
+
+class node {
+
+  friend class graph;
+  friend class task;
+  friend class flow_builder;
+  friend class task_flow;
+  friend class executor;
+
+  struct fixed {
+    std::function<void()> work;
+  }; // struct fixed
+
+  struct dynamic {
+    std::function<void(subflow&)> work;
+    graph subgraph;
+  }; // struct dynamic
+
+  struct condition {
+    std::function<int()> work;
+  }; // struct condition
+
+  using handle_type = std::variant<std::monostate, fixed, dynamic, condition>;
+
+public:
+
+  using size_type = std::size_t;
+
+  template<typename... Args>
+  explicit node(Args&&... args)
+  : _handle{std::forward<Args>(args)...} { }
+
+  ~node() = default;
+
+  auto name() const noexcept -> const std::string& {
+    return _name;
+  }
+
+private:
+
+  auto _precede(node* other) -> void {
+    _successors.push_back(other);
+    other->_dependents.push_back(this);
+  }
+
+  auto _is_condition() const noexcept -> bool {
+    return std::holds_alternative<condition>(_handle);
+  }
+
+  // [NOTE]: Edges that leave a condition task are weak. They do not count towards the join counter, the condition task schedules the selected successor directly
+  auto _prepare(topology* topology, node* parent) -> void {
+    _topology = topology;
+    _parent = parent;
+    _strong_dependents = static_cast<size_type>(std::ranges::count_if(_dependents, [](const auto* dependent) { return !dependent->_is_condition(); }));
+    _join_counter.store(_strong_dependents, std::memory_order_relaxed);
+  }
+
+  std::string _name;
+  handle_type _handle;
+  std::vector<node*> _successors;
+  std::vector<node*> _dependents;
+
+  topology* _topology{nullptr};
+  node* _parent{nullptr};
+  size_type _strong_dependents{0u};
+  std::atomic<size_type> _join_counter{0u};
+  std::atomic<size_type> _pending{0u};
+
+}; // class node
+
+inline graph::graph(graph&& other) noexcept
+: _nodes{std::move(other._nodes)} { }
+
+inline graph::~graph() = default;
+
+inline auto graph::operator=(graph&& other) noexcept -> graph& {
+  _nodes = std::move(other._nodes);
+  return *this;
+}
+
+inline auto graph::clear() -> void {
+  _nodes.clear();
+}
+
+inline auto graph::_erase(node* node) -> void {
+  if (auto entry = std::ranges::find_if(_nodes, [node](const auto& element) { return element.get() == node; }); entry != _nodes.end()) {
+    _nodes.erase(entry);
+  }
+}
+
+template<typename... Args>
+auto graph::_emplace_back(Args&&... args) -> node* {
+  return _nodes.emplace_back(std::make_unique<node>(std::forward<Args>(args)...)).get();
+}
+
+/**
+ * @brief Handle to a node of a task graph
+ */
+class task {
+
+  friend class flow_builder;
+
+public:
+
+  task() noexcept
+  : _node{nullptr} { }
+
+  auto name() const noexcept -> const std::string& {
+    return _node->name();
+  }
+
+  auto name(std::string name) -> task& {
+    _node->_name = std::move(name);
+    return *this;
+  }
+
+  auto is_empty() const noexcept -> bool {
+    return _node == nullptr;
+  }
+
+  /**
+   * @brief Replaces the work of the task
+   *
+   * @param callable Fixed, dynamic or condition work
+   */
+  template<typename Callable>
+  auto work(Callable&& callable) -> task& {
+    if constexpr (is_dynamic_task_v<Callable>) {
+      _node->_handle.emplace<node::dynamic>(std::forward<Callable>(callable));
+    } else if constexpr (is_fixed_task_v<Callable>) {
+      _node->_handle.emplace<node::fixed>(std::forward<Callable>(callable));
+    } else if constexpr (is_condition_task_v<Callable>) {
+      _node->_handle.emplace<node::condition>(std::forward<Callable>(callable));
+    } else {
+      static_assert(std::is_void_v<Callable>, "Invalid task type");
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Makes this task run before the given tasks
+   */
+  template<typename... Tasks>
+  auto precede(Tasks&&... tasks) -> task& {
+    (_node->_precede(tasks._node), ...);
+    return *this;
+  }
+
+  /**
+   * @brief Makes this task run after the given tasks
+   */
+  template<typename... Tasks>
+  auto succeed(Tasks&&... tasks) -> task& {
+    (tasks._node->_precede(_node), ...);
+    return *this;
+  }
+
+  template<typename Visitor>
+  requires (std::is_invocable_r_v<void, Visitor, task>)
+  auto for_each_successor(Visitor&& visitor) const -> void {
+    for (auto* successor : _node->_successors) {
+      std::invoke(visitor, task{successor});
+    }
+  }
+
+  template<typename Visitor>
+  requires (std::is_invocable_r_v<void, Visitor, task>)
+  auto for_each_dependent(Visitor&& visitor) const -> void {
+    for (auto* dependent : _node->_dependents) {
+      std::invoke(visitor, task{dependent});
+    }
+  }
+
+  friend auto operator==(const task& lhs, const task& rhs) noexcept -> bool {
+    return lhs._node == rhs._node;
+  }
+
+private:
+
+  explicit task(node* node) noexcept
+  : _node{node} { }
+
+  node* _node;
+
+}; // class task
+
+/**
+ * @brief Adds tasks to a graph
+ */
+class flow_builder {
+
+public:
+
+  explicit flow_builder(graph& graph) noexcept
+  : _graph{&graph} { }
+
+  template<typename Callable>
+  requires (is_fixed_task_v<Callable> || is_dynamic_task_v<Callable> || is_condition_task_v<Callable>)
+  auto emplace(Callable&& callable) -> task {
+    if constexpr (is_dynamic_task_v<Callable>) {
+      return task{_graph->_emplace_back(std::in_place_type<node::dynamic>, node::dynamic{std::forward<Callable>(callable), graph{}})};
+    } else if constexpr (is_fixed_task_v<Callable>) {
+      return task{_graph->_emplace_back(std::in_place_type<node::fixed>, std::forward<Callable>(callable))};
+    } else {
+      return task{_graph->_emplace_back(std::in_place_type<node::condition>, std::forward<Callable>(callable))};
+    }
+  }
+
+  template<typename... Callables>
+  requires (sizeof...(Callables) > 1)
+  auto emplace(Callables&&... callables) -> decltype(auto) {
+    return std::make_tuple(emplace(std::forward<Callables>(callables))...);
+  }
+
+  /**
+   * @brief Adds a task without work. Useful to join or fork other tasks
+   */
+  auto placeholder() -> task {
+    return task{_graph->_emplace_back()};
+  }
+
+  /**
+   * @brief Removes a task and all of its edges
+   *
+   * @param task The task to remove
+   */
+  auto erase(const task& task) -> void {
+    if (task.is_empty()) {
+      return;
+    }
+
+    auto* erased = task._node;
+
+    for (auto* dependent : erased->_dependents) {
+      std::erase(dependent->_successors, erased);
+    }
+
+    for (auto* successor : erased->_successors) {
+      std::erase(successor->_dependents, erased);
+    }
+
+    _graph->_erase(erased);
+  }
+
+protected:
+
+  graph* _graph;
+
+}; // class flow_builder
+
+/**
+ * @brief Builder that is passed to dynamic tasks. The tasks it adds run after the dynamic task returns and the dynamic
+ * task only completes once all of them have completed
+ */
+class subflow : public flow_builder {
+
+  friend class executor;
+
+  explicit subflow(graph& graph) noexcept
+  : flow_builder{graph} { }
+
+}; // class subflow
+
+/**
+ * @brief Task graph that is built once and can be run any number of times by an executor
+ *
+ * @note The graph must not be modified while it runs
+ */
+class task_flow : public flow_builder {
+
+  friend class executor;
+
+public:
+
+  explicit task_flow(std::string name = {})
+  : flow_builder{_graph},
+    _name{std::move(name)} { }
+
+  task_flow(const task_flow&) = delete;
+
+  task_flow(task_flow&&) = delete;
+
+  ~task_flow() = default;
+
+  auto operator=(const task_flow&) -> task_flow& = delete;
+
+  auto operator=(task_flow&&) -> task_flow& = delete;
+
+  auto name() const noexcept -> const std::string& {
+    return _name;
+  }
+
+  auto size() const noexcept -> std::size_t {
+    return _graph.size();
+  }
+
+  auto clear() -> void {
+    _graph.clear();
+  }
+
+  auto is_empty() const noexcept -> bool {
+    return _graph.is_empty();
+  }
+
+private:
+
+  std::string _name;
+  graph _graph;
+
+  std::mutex _mutex;
+  std::list<topology> _topologies;
+
+}; // class task_flow
+
+} // namespace ecs
+
+#endif // LIBECS_TASK_GRAPH_HPP_
@@ -0,0 +1,199 @@
+#ifndef LIBECS_THREAD_POOL_HPP_
+#define LIBECS_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ecs {
+
+/**
+ * @brief Executor that can run a function for a range of indices, possibly concurrently, and blocks until all of them
+ * are done
+ */
+template<typename Executor>
+concept parallel_executor = requires(Executor& executor, std::size_t count, void(*func)(std::size_t)) {
+  executor.parallel_for(count, func);
+};
+
+/**
+ * @brief Fixed set of worker threads for data parallel loops. The calling thread takes part in each loop and indices
+ * are handed out one at a time, so uneven chunks balance themselves
+ *
+ * @note Applications that also run task flows can pass their executor to par_each instead, so that a single set of
+ * worker threads serves both
+ */
+class thread_pool {
+
+public:
+
+  using size_type = std::size_t;
+
+  /**
+   * @brief Starts the worker threads
+   *
+   * @param threads Total number of threads that run a loop, including the calling thread
+   */
+  explicit thread_pool(const size_type threads = std::max(std::thread::hardware_concurrency(), 1u)) {
+    const auto workers = std::max(threads, size_type{1}) - 1u;
+
+    _workers.reserve(workers);
+
+    for (auto index = size_type{0}; index < workers; ++index) {
+      _workers.emplace_back([this]() { _run(); });
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+
+  thread_pool(thread_pool&&) = delete;
+
+  ~thread_pool() {
+    {
+      const auto lock = std::lock_guard{_mutex};
+      _stop = true;
+    }
+
+    _wake.notify_all();
+
+    for (auto& worker : _workers) {
+      worker.join();
+    }
+  }
+
+  auto operator=(const thread_pool&) -> thread_pool& = delete;
+
+  auto operator=(thread_pool&&) -> thread_pool& = delete;
+
+  /**
+   * @brief Gets the number of threads that run a loop, including the calling thread
+   *
+   * @return
+   */
+  auto size() const noexcept -> size_type {
+    return _workers.size() + 1u;
+  }
+
+  /**
+   * @brief Invokes a function for every index in [0, count) and waits for all invocations to finish
+   *
+   * @note Invocations run concurrently on different threads. Loops must not be nested and must not be started from
+   * multiple threads at once
+   *
+   * @param count Number of indices
+   * @param func Function that takes an index
+   *
+   * @throws The first exception that was thrown by one of the invocations
+   */
+  template<typename Func>
+  requires (std::invocable<Func&, size_type>)
+  auto parallel_for(const size_type count, Func func) -> void {
+    if (count == 0u) {
+      return;
+    }
+
+    if (_workers.empty() || count == 1u) {
+      for (auto index = size_type{0}; index < count; ++index) {
+        func(index);
+      }
+
+      return;
+    }
+
+    {
+      const auto lock = std::lock_guard{_mutex};
+
+      _context = std::addressof(func);
+      _invoke = [](void* context, const size_type index) { (*static_cast<Func*>(context))(index); };
+      _count = count;
+      _next.store(0u, std::memory_order_relaxed);
+      _busy = _workers.size();
+      _exception = nullptr;
+      ++_generation;
+    }
+
+    _wake.notify_all();
+
+    _work();
+
+    auto lock = std::unique_lock{_mutex};
+    _done.wait(lock, [this]() { return _busy == 0u; });
+
+    if (_exception) {
+      std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+  }
+
+private:
+
+  auto _run() -> void {
+    auto generation = size_type{0};
+
+    while (true) {
+      {
+        auto lock = std::unique_lock{_mutex};
+        _wake.wait(lock, [this, generation]() { return _stop || _generation != generation; });
+
+        if (_stop) {
+          return;
+        }
+
+        generation = _generation;
+      }
+
+      _work();
+
+      {
+        const auto lock = std::lock_guard{_mutex};
+
+        if (--_busy == 0u) {
+          _done.notify_one();
+        }
+      }
+    }
+  }
+
+  auto _work() -> void {
+    for (auto index = _next.fetch_add(1u, std::memory_order_relaxed); index < _count; index = _next.fetch_add(1u, std::memory_order_relaxed)) {
+      try {
+        _invoke(_context, index);
+      } catch (...) {
+        const auto lock = std::lock_guard{_mutex};
+
+        if (!_exception) {
+          _exception = std::current_exception();
+        }
+
+        // [NOTE]: Claiming all remaining indices stops the other threads after their current invocation
+        _next.store(_count, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::vector<std::thread> _workers;
+
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+
+  void* _context{nullptr};
+  void (*_invoke)(void*, size_type){nullptr};
+  size_type _count{0u};
+  std::atomic<size_type> _next{0u};
+  size_type _busy{0u};
+  size_type _generation{0u};
+  std::exception_ptr _exception;
+  bool _stop{false};
+
+}; // class thread_pool
+
+} // namespace ecs
+
+#endif // LIBECS_THREAD_POOL_HPP_
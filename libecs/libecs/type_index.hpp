@@ -0,0 +1,77 @@
+#ifndef LIBECS_TYPE_INDEX_HPP_
+#define LIBECS_TYPE_INDEX_HPP_
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace ecs {
+
+/**
+ * @brief Number of indices that are reserved for pinned types. Sequential indices start right after them, so pinned and
+ * sequential indices never collide
+ */
+inline constexpr auto pinned_type_index_count_v = std::size_t{16u};
+
+namespace detail {
+
+struct type_index_counter {
+  static auto next() noexcept -> std::size_t {
+    static auto value = std::atomic<std::size_t>{pinned_type_index_count_v};
+    return value.fetch_add(1u, std::memory_order_relaxed);
+  }
+}; // struct type_index_counter
+
+} // namespace detail
+
+/**
+ * @brief Pins the index of a type, e.g. to make serialized data or multiple processes agree on it. Specialize with a
+ * static constexpr value below pinned_type_index_count_v
+ *
+ * @note Pinned indices have to be unique among the pinned types
+ *
+ * @tparam Type Type to pin the index of
+ */
+template<typename Type>
+struct pinned_type_index { }; // struct pinned_type_index
+
+template<typename Type>
+concept pinned_type = requires {
+  { pinned_type_index<Type>::value } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * @brief Sequential per process index of a type. The first type that is queried gets the first index after the pinned
+ * ones, the next one the index after that and so on. Types with a pinned_type_index specialization get the pinned index
+ *
+ * @tparam Type Type to get the index for
+ */
+template<typename Type>
+struct type_index final {
+  [[nodiscard]] static auto value() noexcept -> std::size_t {
+    if constexpr (pinned_type<Type>) {
+      static_assert(pinned_type_index<Type>::value < pinned_type_index_count_v, "Pinned type index must be below pinned_type_index_count_v");
+      return pinned_type_index<Type>::value;
+    } else {
+      static const auto value = detail::type_index_counter::next();
+      return value;
+    }
+  }
+}; // struct type_index
+
+/**
+ * @brief Gets the sequential index of a type ignoring cv-qualifiers and references
+ *
+ * @tparam Type Type to get the index for
+ *
+ * @return The index of the type
+ */
+template<typename Type>
+[[nodiscard]] auto type_id() noexcept -> std::size_t {
+  return type_index<std::remove_cvref_t<Type>>::value();
+}
+
+} // namespace ecs
+
+#endif // LIBECS_TYPE_INDEX_HPP_
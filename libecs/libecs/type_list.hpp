@@ -1,6 +1,7 @@
 #ifndef LIBECS_TYPE_LIST_HPP_
 #define LIBECS_TYPE_LIST_HPP_
 
+#include <cinttypes>
 #include <utility>
 
 namespace ecs {
@@ -41,6 +42,67 @@ struct type_list_index<Type, type_list<>> {
 template<typename Type, typename List>
 inline constexpr std::size_t type_list_index_v = type_list_index<Type, List>::value;
 
+/** @brief List of component types whose storages are owned by a group */
+template<typename... Type>
+struct owned_t final : type_list<Type...> {
+  explicit constexpr owned_t() = default;
+}; // struct owned_t
+
+template<typename... Type>
+inline constexpr owned_t<Type...> owned{};
+
+/** @brief List of component types that are required but not owned */
+template<typename... Type>
+struct get_t final : type_list<Type...> {
+  explicit constexpr get_t() = default;
+}; // struct get_t
+
+template<typename... Type>
+inline constexpr get_t<Type...> get{};
+
+/** @brief List of component types that must not be assigned */
+template<typename... Type>
+struct exclude_t final : type_list<Type...> {
+  explicit constexpr exclude_t() = default;
+}; // struct exclude_t
+
+template<typename... Type>
+inline constexpr exclude_t<Type...> exclude{};
+
+/** @brief List of component types that are fetched if they are assigned but do not filter entities */
+template<typename... Type>
+struct optional_t final : type_list<Type...> {
+  explicit constexpr optional_t() = default;
+}; // struct optional_t
+
+template<typename... Type>
+inline constexpr optional_t<Type...> optional{};
+
+/** @brief Counter that orders changes to components. Tick 0 is older than any change */
+using tick_type = std::uint64_t;
+
+/** @brief Filters a view by the components of a type that have been changed after a tick */
+template<typename Type>
+struct changed_t final {
+  tick_type since;
+}; // struct changed_t
+
+template<typename Type>
+[[nodiscard]] constexpr auto changed(const tick_type since) noexcept -> changed_t<Type> {
+  return changed_t<Type>{since};
+}
+
+/** @brief Filters a view by the components of a type that have been added after a tick */
+template<typename Type>
+struct added_t final {
+  tick_type since;
+}; // struct added_t
+
+template<typename Type>
+[[nodiscard]] constexpr auto added(const tick_type since) noexcept -> added_t<Type> {
+  return added_t<Type>{since};
+}
+
 } // namespace ecs
 
 #endif // LIBECS_TYPE_LIST_HPP_
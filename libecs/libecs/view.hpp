@@ -6,17 +6,90 @@
 #include <ranges>
 #include <vector>
 #include <array>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
 #include <libecs/memory.hpp>
 #include <libecs/component_handle.hpp>
+#include <libecs/component_traits.hpp>
 #include <libecs/type_list.hpp>
 #include <libecs/iterable_adaptor.hpp>
+#include <libecs/thread_pool.hpp>
 
 namespace ecs {
 
 namespace detail {
 
-template<typename Container, std::size_t Size>
+template<typename Func, typename Tuple>
+struct is_applicable : std::false_type { };
+
+template<typename Func, typename... Args>
+struct is_applicable<Func, std::tuple<Args...>> : std::is_invocable<Func, Args...> { };
+
+template<typename Func, typename Tuple>
+inline constexpr auto is_applicable_v = is_applicable<Func, Tuple>::value;
+
+/**
+ * @brief Gets the value at a position of the dense array of a storage as a tuple. Empty types yield an empty tuple.
+ * Mutable access marks the value as changed if the storage tracks changes
+ *
+ * @param container The storage
+ * @param index Position in the dense array
+ */
+template<typename Container>
+auto dense_as_tuple(Container& container, const std::ptrdiff_t index) {
+  if constexpr (std::is_empty_v<typename Container::value_type>) {
+    return std::tuple<>{};
+  } else {
+    if constexpr (!std::is_const_v<Container> && Container::track_changes_v) {
+      container.mark_changed_at(static_cast<std::size_t>(index));
+    }
+
+    // [NOTE]: Storages of whole components yield references, structure of arrays storages yield proxies by value
+    return std::tuple<decltype(container.begin()[index])>{container.begin()[index]};
+  }
+}
+
+/**
+ * @brief Predicate that accepts every position of the dense array
+ */
+struct any_tick final {
+  constexpr auto operator()([[maybe_unused]] const std::ptrdiff_t index) const noexcept -> bool {
+    return true;
+  }
+}; // struct any_tick
+
+/**
+ * @brief Gets a predicate that accepts the positions of the dense array of a storage whose values have been changed
+ * or added after a tick
+ */
+template<typename Container, typename Type>
+auto tick_filter(const Container& container, const changed_t<Type> filter) noexcept {
+  static_assert(Container::track_changes_v, "Component type does not track changes");
+  return [&container, since = filter.since](const std::ptrdiff_t index) { return container.changed_at(static_cast<std::size_t>(index)) > since; };
+}
+
+template<typename Container, typename Type>
+auto tick_filter(const Container& container, const added_t<Type> filter) noexcept {
+  static_assert(Container::track_changes_v, "Component type does not track changes");
+  return [&container, since = filter.since](const std::ptrdiff_t index) { return container.added_at(static_cast<std::size_t>(index)) > since; };
+}
+
+/**
+ * @brief Invokes a function with the entity followed by its components, or with the components alone if the function
+ * does not take the entity
+ */
+template<typename Func, typename Entity, typename Components>
+auto invoke_each(Func& func, const Entity entity, Components&& components) -> void {
+  if constexpr (is_applicable_v<Func&, decltype(std::tuple_cat(std::make_tuple(entity), std::forward<Components>(components)))>) {
+    std::apply(func, std::tuple_cat(std::make_tuple(entity), std::forward<Components>(components)));
+  } else {
+    std::apply(func, std::forward<Components>(components));
+  }
+}
+
+template<typename Container, std::size_t Size, std::size_t Exclude = 0u>
 class view_iterator {
 
   using iterator_type = typename Container::const_iterator;
@@ -27,17 +100,19 @@ public:
   using pointer = typename iterator_type::pointer;
   using reference = typename iterator_type::reference;
   using difference_type = typename iterator_type::difference_type;
-  using iterator_category = std::forward_iterator_tag;
+  using iterator_category = std::bidirectional_iterator_tag;
 
   constexpr view_iterator() noexcept
   : _current{},
     _end{},
-    _containers{} { }
+    _containers{},
+    _filter{} { }
 
-  view_iterator(iterator_type current, iterator_type end, std::array<const Container*, Size> containers) noexcept
+  view_iterator(iterator_type current, iterator_type end, std::array<const Container*, Size> containers, std::array<const Container*, Exclude> filter = {}) noexcept
   : _current{current},
     _end{end},
-    _containers{containers} {
+    _containers{containers},
+    _filter{filter} {
     while(_current != _end && !_is_valid()) {
       ++_current;
     }
@@ -54,6 +129,17 @@ public:
     return copy;
   }
 
+  auto operator--() noexcept -> view_iterator& {
+    while(!(--_current, _is_valid())) {}
+    return *this;
+  }
+
+  auto operator--(int) noexcept -> view_iterator {
+    auto copy = *this;
+    --(*this);
+    return copy;
+  }
+
   auto operator->() const noexcept -> pointer {
     return &*_current;
   }
@@ -62,20 +148,22 @@ public:
     return *(operator->());
   }
 
-  template<typename LhsContainer, std::size_t LhsSize, typename RhsContainer, std::size_t RhsSize>
-  friend auto operator==(const view_iterator<LhsContainer, LhsSize>& lhs, const view_iterator<RhsContainer, RhsSize>& rhs) noexcept -> bool {
+  friend auto operator==(const view_iterator& lhs, const view_iterator& rhs) noexcept -> bool {
     return lhs._current == rhs._current;
   } 
 
 private:
 
   auto _is_valid() const noexcept -> bool {
-    return (Size != 0u) && std::apply([entity = *_current](const auto*... container){ return (container->contains(entity) && ...); }, _containers);
+    return !Container::is_tombstone(*_current)
+      && std::apply([entity = *_current](const auto*... container){ return (container->contains(entity) && ...); }, _containers)
+      && std::apply([entity = *_current](const auto*... container){ return !(container->contains(entity) || ...); }, _filter);
   }
 
   iterator_type _current;
   iterator_type _end;
   std::array<const Container*, Size> _containers;
+  std::array<const Container*, Exclude> _filter;
 
 }; // class view_iterator
 
@@ -104,25 +192,30 @@ private:
 
 }; // struct input_iterator_pointer
 
-template<typename Iterator, typename... Types>
-class extended_view_iterator final {
+template<typename, typename, typename>
+class extended_view_iterator;
+
+template<typename Iterator, typename... Types, typename... Optionals>
+class extended_view_iterator<Iterator, get_t<Types...>, optional_t<Optionals...>> final {
 
 public:
 
   using iterator_type = Iterator;
   using difference_type = std::ptrdiff_t;
-  using value_type = decltype(std::tuple_cat(std::make_tuple(*std::declval<Iterator>()), std::declval<Types>().as_tuple({})...));
+  using value_type = decltype(std::tuple_cat(std::make_tuple(*std::declval<Iterator>()), std::declval<Types>().as_tuple({})..., std::make_tuple(std::declval<Optionals>().try_get({})...)));
   using pointer = input_iterator_pointer<value_type>;
   using reference = value_type;
   using iterator_category = std::input_iterator_tag;
 
   constexpr extended_view_iterator()
   : _iterator{},
-    _containers{} {}
+    _containers{},
+    _optionals{} {}
 
-  extended_view_iterator(iterator_type iterator, std::tuple<Types*...> containers)
+  extended_view_iterator(iterator_type iterator, std::tuple<Types*...> containers, std::tuple<Optionals*...> optionals = {})
   : _iterator{iterator},
-    _containers{containers} {}
+    _containers{containers},
+    _optionals{optionals} {}
 
   extended_view_iterator &operator++() noexcept {
     ++_iterator;
@@ -136,7 +229,12 @@ public:
   }
 
   [[nodiscard]] reference operator*() const noexcept {
-    return std::apply([current = *_iterator](auto*... container) { return std::tuple_cat(std::make_tuple(current), container->as_tuple(current)...); }, _containers);
+    const auto current = *_iterator;
+
+    return std::tuple_cat(
+      std::apply([current](auto*... container) { return std::tuple_cat(std::make_tuple(current), container->as_tuple(current)...); }, _containers),
+      std::apply([current](auto*... optional) { return std::make_tuple(optional->try_get(current)...); }, _optionals)
+    );
   }
 
   [[nodiscard]] pointer operator->() const noexcept {
@@ -147,8 +245,7 @@ public:
     return _iterator;
   }
 
-  template<typename... Lhs, typename... Rhs>
-  friend bool constexpr operator==(const extended_view_iterator<Lhs...>& lhs, const extended_view_iterator<Rhs...>& rhs) noexcept {
+  friend bool constexpr operator==(const extended_view_iterator& lhs, const extended_view_iterator& rhs) noexcept {
     return lhs._iterator == rhs._iterator;
   }
 
@@ -156,13 +253,25 @@ private:
 
   iterator_type _iterator;
   std::tuple<Types*...> _containers;
+  std::tuple<Optionals*...> _optionals;
 
 }; // class extended_view_iterator
 
 } // namespace detail
 
-template<typename... Containers>
-class basic_view {
+template<typename, typename = exclude_t<>, typename = optional_t<>>
+class basic_view;
+
+/**
+ * @brief View over the entities that have all of the required components and none of the excluded ones. Optional
+ * components are yielded as pointers by each() and are nullptr when an entity does not have them
+ *
+ * @tparam Containers Types of the required storages
+ * @tparam Filters Types of the excluded storages
+ * @tparam Optionals Types of the optional storages
+ */
+template<typename... Containers, typename... Filters, typename... Optionals>
+class basic_view<get_t<Containers...>, exclude_t<Filters...>, optional_t<Optionals...>> {
 
   using underlying_type = std::common_type_t<typename Containers::key_type...>;
   using basic_common_type = std::common_type_t<typename Containers::base_type...>;
@@ -180,17 +289,17 @@ public:
   using entity_type = underlying_type;
   using size_type = std::size_t;
   using base_type = basic_common_type;
-  using iterator = detail::view_iterator<base_type, sizeof...(Containers) - 1u>;
-  using iterable = iterable_adaptor<detail::extended_view_iterator<iterator, Containers...>>;
+  using iterator = detail::view_iterator<base_type, sizeof...(Containers) - 1u, sizeof...(Filters)>;
+  using iterable = iterable_adaptor<detail::extended_view_iterator<iterator, get_t<Containers...>, optional_t<Optionals...>>>;
 
   ~basic_view() = default;
   
   auto begin() const noexcept -> iterator {
-    return iterator{handle().begin(), handle().end(), _check()};
+    return iterator{handle().begin(), handle().end(), _check(), _filter};
   }
 
   auto end() const noexcept -> iterator {
-    return iterator{handle().end(), handle().end(), _check()};
+    return iterator{handle().end(), handle().end(), _check(), _filter};
   }
 
   auto handle() const noexcept -> const base_type& {
@@ -220,16 +329,130 @@ public:
   }
 
   auto each() const noexcept -> iterable {
-    return iterable{detail::extended_view_iterator{begin(), _containers}, detail::extended_view_iterator{end(), _containers}};
+    using each_iterator = typename iterable::iterator;
+    return iterable{each_iterator{begin(), _containers, _optionals}, each_iterator{end(), _containers, _optionals}};
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view. The function takes the entity followed by the components,
+   * or the components alone. Empty components are not passed and optional components are passed as pointers
+   *
+   * @note The pivot storage is walked by index and its components are read from their dense position, only the other
+   * storages are looked up
+   *
+   * @param func The function to invoke
+   */
+  template<typename Func>
+  auto each(Func func) const -> void {
+    _each(func, 0u, handle().size(), std::index_sequence_for<Containers...>{});
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view whose component of the given type has been changed after a
+   * tick. Adding a component counts as a change
+   *
+   * @note The storage of the filtered type is walked instead of the smallest one. For entities that have not changed
+   * only its tick array is read
+   *
+   * @param filter The filtered type and the tick
+   * @param func The function to invoke, with the same signature as for each
+   */
+  template<typename Type, typename Func>
+  auto each(const changed_t<Type> filter, Func func) const -> void {
+    const auto& container = storage<Type>();
+    _each<index_of<Type>>(func, 0u, container.size(), std::index_sequence_for<Containers...>{}, detail::tick_filter(container, filter));
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view whose component of the given type has been added after a
+   * tick
+   *
+   * @param filter The filtered type and the tick
+   * @param func The function to invoke, with the same signature as for each
+   */
+  template<typename Type, typename Func>
+  auto each(const added_t<Type> filter, Func func) const -> void {
+    const auto& container = storage<Type>();
+    _each<index_of<Type>>(func, 0u, container.size(), std::index_sequence_for<Containers...>{}, detail::tick_filter(container, filter));
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view on multiple threads. The dense array of the pivot storage is
+   * split into chunks of consecutive positions and each chunk is handed to the executor
+   *
+   * @note Every entity is visited once and by one thread only, so the components passed to different invocations never
+   * alias. The function is shared by all threads and must be safe to invoke concurrently. While the call runs, no
+   * component may be added or removed and no entity created or destroyed, and other components must only be read
+   *
+   * @param executor Executor that runs the chunks
+   * @param func The function to invoke, with the same signature as for each
+   * @param grain_size Number of positions of the pivot storage per chunk
+   */
+  template<parallel_executor Executor, typename Func>
+  auto par_each(Executor& executor, Func func, const size_type grain_size = 1024u) const -> void {
+    const auto size = handle().size();
+    const auto grain = std::max(grain_size, size_type{1});
+
+    executor.parallel_for((size + grain - 1u) / grain, [this, &func, size, grain](const size_type chunk) {
+      _each(func, chunk * grain, std::min(size, (chunk + 1u) * grain), std::index_sequence_for<Containers...>{});
+    });
   }
 
 private:
 
+  template<typename Func, std::size_t... Index>
+  auto _each(Func& func, const size_type first, const size_type last, std::index_sequence<Index...> sequence) const -> void {
+    // [NOTE]: The pivot is selected at runtime, dispatching on it lets the loop know at compile time which storage it walks
+    [[maybe_unused]] const auto found = ((std::get<Index>(_containers) == _view && (_each<Index>(func, first, last, sequence, detail::any_tick{}), true)) || ...);
+  }
+
+  template<std::size_t Pivot, typename Func, typename Filter, std::size_t... Index>
+  auto _each(Func& func, const size_type first_index, const size_type last_index, std::index_sequence<Index...>, Filter filter) const -> void {
+    const base_type& pivot = *std::get<Pivot>(_containers);
+
+    auto first = std::next(pivot.begin(), static_cast<std::ptrdiff_t>(first_index));
+    const auto last = std::next(pivot.begin(), static_cast<std::ptrdiff_t>(last_index));
+
+    for (auto index = static_cast<std::ptrdiff_t>(first_index); first != last; ++first, ++index) {
+      if (!filter(index)) {
+        continue;
+      }
+
+      const auto entity = *first;
+
+      if (base_type::is_tombstone(entity) || !_contains_others<Pivot>(entity, std::index_sequence<Index...>{})) {
+        continue;
+      }
+
+      detail::invoke_each(func, entity, std::tuple_cat(
+        _components_at<Index, Pivot>(entity, index)...,
+        std::apply([entity](auto*... optional) { return std::make_tuple(optional->try_get(entity)...); }, _optionals)
+      ));
+    }
+  }
+
+  template<std::size_t Pivot, std::size_t... Index>
+  auto _contains_others(const entity_type entity, std::index_sequence<Index...>) const noexcept -> bool {
+    return ((Index == Pivot || std::get<Index>(_containers)->contains(entity)) && ...)
+      && std::ranges::none_of(_filter, [entity](const auto* filter) { return filter->contains(entity); });
+  }
+
+  template<std::size_t Index, std::size_t Pivot>
+  auto _components_at(const entity_type entity, const std::ptrdiff_t index) const {
+    if constexpr (Index == Pivot) {
+      return detail::dense_as_tuple(*std::get<Index>(_containers), index);
+    } else {
+      return std::get<Index>(_containers)->as_tuple(entity);
+    }
+  }
+
   basic_view() noexcept = default;
 
-  basic_view(Containers&... containers) noexcept
+  basic_view(Containers&... containers, Filters&... filters, Optionals&... optionals) noexcept
   : _containers{&containers...},
-    _view{std::get<0>(_containers)} {
+    _view{std::get<0>(_containers)},
+    _filter{&filters...},
+    _optionals{&optionals...} {
     ((_view = containers.size() < _view->size() ? &containers : _view), ...);
   }
 
@@ -243,11 +466,13 @@ private:
 
   container_storage_type _containers;
   const base_type* _view;
+  std::array<const base_type*, sizeof...(Filters)> _filter;
+  std::tuple<Optionals*...> _optionals;
 
 }; // class basic_view
 
 template<typename Container>
-class basic_view<Container> {
+class basic_view<get_t<Container>, exclude_t<>, optional_t<>> {
 
   template<typename Entity, allocator_for<Entity> Allocator>
   friend class basic_registry;
@@ -257,7 +482,7 @@ public:
   using entity_type = typename Container::key_type;
   using size_type = std::size_t;
   using base_type = typename Container::base_type;
-  using iterator = typename base_type::const_iterator;
+  using iterator = detail::view_iterator<base_type, 0u>;
 
   basic_view() noexcept
   : _container{},
@@ -268,11 +493,11 @@ public:
     _view{&container} { }
 
   auto begin() const noexcept -> iterator {
-    return handle().begin();
+    return iterator{handle().begin(), handle().end(), {}};
   }
 
   auto end() const noexcept -> iterator {
-    return handle().end();
+    return iterator{handle().end(), handle().end(), {}};
   }
 
   auto handle() const noexcept -> const base_type& {
@@ -294,8 +519,93 @@ public:
     return storage().get(entity);
   }
 
+  /**
+   * @brief Gets the array of one data member of the components, in the same order as the entities of handle()
+   *
+   * @note Only for components that are stored as structure of arrays. Loops over a single member read only that array
+   *
+   * @tparam Member Pointer to the data member
+   *
+   * @return
+   */
+  template<auto Member>
+  requires (soa_component<typename Container::value_type>)
+  auto field() const noexcept -> decltype(auto) {
+    return storage().template field<Member>();
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view. The function takes the entity followed by the component,
+   * or the component alone. Empty components are not passed
+   *
+   * @param func The function to invoke
+   */
+  template<typename Func>
+  auto each(Func func) const -> void {
+    _each(func, 0u, handle().size(), detail::any_tick{});
+  }
+
+  /**
+   * @brief Invokes a function for each entity whose component has been changed after a tick. Adding a component counts
+   * as a change
+   *
+   * @param filter The tick
+   * @param func The function to invoke, with the same signature as for each
+   */
+  template<typename Type, typename Func>
+  requires (std::is_same_v<std::remove_const_t<Type>, typename Container::value_type>)
+  auto each(const changed_t<Type> filter, Func func) const -> void {
+    _each(func, 0u, handle().size(), detail::tick_filter(storage(), filter));
+  }
+
+  /**
+   * @brief Invokes a function for each entity whose component has been added after a tick
+   *
+   * @param filter The tick
+   * @param func The function to invoke, with the same signature as for each
+   */
+  template<typename Type, typename Func>
+  requires (std::is_same_v<std::remove_const_t<Type>, typename Container::value_type>)
+  auto each(const added_t<Type> filter, Func func) const -> void {
+    _each(func, 0u, handle().size(), detail::tick_filter(storage(), filter));
+  }
+
+  /**
+   * @brief Invokes a function for each entity of the view on multiple threads. The dense array of the storage is
+   * split into chunks of consecutive positions and each chunk is handed to the executor
+   *
+   * @note Every entity is visited once and by one thread only, so the components passed to different invocations never
+   * alias. The function is shared by all threads and must be safe to invoke concurrently. While the call runs, no
+   * component may be added or removed and no entity created or destroyed
+   *
+   * @param executor Executor that runs the chunks
+   * @param func The function to invoke, with the same signature as for each
+   * @param grain_size Number of positions of the storage per chunk
+   */
+  template<parallel_executor Executor, typename Func>
+  auto par_each(Executor& executor, Func func, const size_type grain_size = 1024u) const -> void {
+    const auto size = handle().size();
+    const auto grain = std::max(grain_size, size_type{1});
+
+    executor.parallel_for((size + grain - 1u) / grain, [this, &func, size, grain](const size_type chunk) {
+      _each(func, chunk * grain, std::min(size, (chunk + 1u) * grain), detail::any_tick{});
+    });
+  }
+
 private:
 
+  template<typename Func, typename Filter>
+  auto _each(Func& func, const size_type first_index, const size_type last_index, Filter filter) const -> void {
+    auto first = std::next(handle().begin(), static_cast<std::ptrdiff_t>(first_index));
+    const auto last = std::next(handle().begin(), static_cast<std::ptrdiff_t>(last_index));
+
+    for (auto index = static_cast<std::ptrdiff_t>(first_index); first != last; ++first, ++index) {
+      if (const auto entity = *first; filter(index) && !base_type::is_tombstone(entity)) {
+        detail::invoke_each(func, entity, detail::dense_as_tuple(storage(), index));
+      }
+    }
+  }
+
   std::tuple<Container*> _container;
   const base_type* _view;
 
@@ -0,0 +1,191 @@
+#ifndef LIBECS_WORK_STEALING_QUEUE_HPP_
+#define LIBECS_WORK_STEALING_QUEUE_HPP_
+
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libecs/memory.hpp>
+
+namespace ecs {
+
+/**
+ * @brief Lock free single producer, multi consumer deque (Chase-Lev). The owning thread pushes and pops at the
+ * bottom, other threads steal from the top
+ *
+ * @note Buffers that are replaced while growing are kept alive until the queue is destroyed, since a thief may still
+ * read from them. Once the queue has grown to its working size, pushing does not allocate
+ *
+ * @tparam Type Type of the elements. Must be trivially copyable
+ */
+template<typename Type>
+requires (std::is_trivially_copyable_v<Type>)
+class work_stealing_queue {
+
+  class buffer {
+
+  public:
+
+    explicit buffer(const std::int64_t capacity)
+    : _capacity{capacity},
+      _mask{capacity - 1},
+      _elements{std::make_unique<std::atomic<Type>[]>(static_cast<std::size_t>(capacity))} { }
+
+    auto capacity() const noexcept -> std::int64_t {
+      return _capacity;
+    }
+
+    auto store(const std::int64_t index, const Type value) noexcept -> void {
+      _elements[static_cast<std::size_t>(index & _mask)].store(value, std::memory_order_relaxed);
+    }
+
+    auto load(const std::int64_t index) const noexcept -> Type {
+      return _elements[static_cast<std::size_t>(index & _mask)].load(std::memory_order_relaxed);
+    }
+
+    auto grow(const std::int64_t bottom, const std::int64_t top) const -> std::unique_ptr<buffer> {
+      auto result = std::make_unique<buffer>(_capacity * 2);
+
+      for (auto index = top; index != bottom; ++index) {
+        result->store(index, load(index));
+      }
+
+      return result;
+    }
+
+  private:
+
+    std::int64_t _capacity;
+    std::int64_t _mask;
+    std::unique_ptr<std::atomic<Type>[]> _elements;
+
+  }; // class buffer
+
+public:
+
+  using value_type = Type;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Constructs an empty queue
+   *
+   * @param capacity Initial capacity. Must be a power of two
+   */
+  explicit work_stealing_queue(const size_type capacity = 1024u) {
+    if (!is_power_of_two(capacity)) {
+      throw std::invalid_argument{"Queue capacity must be a power of two"};
+    }
+
+    _buffers.push_back(std::make_unique<buffer>(static_cast<std::int64_t>(capacity)));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+  }
+
+  work_stealing_queue(const work_stealing_queue&) = delete;
+
+  auto operator=(const work_stealing_queue&) -> work_stealing_queue& = delete;
+
+  auto empty() const noexcept -> bool {
+    const auto bottom = _bottom.load(std::memory_order_relaxed);
+    const auto top = _top.load(std::memory_order_relaxed);
+    return bottom <= top;
+  }
+
+  auto size() const noexcept -> size_type {
+    const auto bottom = _bottom.load(std::memory_order_relaxed);
+    const auto top = _top.load(std::memory_order_relaxed);
+    return static_cast<size_type>(bottom >= top ? bottom - top : 0);
+  }
+
+  /**
+   * @brief Pushes an element to the bottom. Must only be called by the owning thread
+   *
+   * @param value
+   */
+  auto push(const value_type value) -> void {
+    const auto bottom = _bottom.load(std::memory_order_relaxed);
+    const auto top = _top.load(std::memory_order_acquire);
+    auto* current = _buffer.load(std::memory_order_relaxed);
+
+    if (current->capacity() - 1 < bottom - top) {
+      _buffers.push_back(current->grow(bottom, top));
+      current = _buffers.back().get();
+      _buffer.store(current, std::memory_order_release);
+    }
+
+    current->store(bottom, value);
+    _bottom.store(bottom + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Pops an element from the bottom. Must only be called by the owning thread
+   *
+   * @return The element or std::nullopt when the queue is empty
+   */
+  auto pop() -> std::optional<value_type> {
+    const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    auto* current = _buffer.load(std::memory_order_relaxed);
+
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    auto result = std::optional<value_type>{current->load(bottom)};
+
+    // [NOTE]: The last element may be stolen concurrently, the owner has to win the race on top to keep it
+    if (top == bottom) {
+      if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        result = std::nullopt;
+      }
+
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Steals an element from the top. May be called by any thread
+   *
+   * @return The element or std::nullopt when the queue is empty or another thread won the race for the element
+   */
+  auto steal() -> std::optional<value_type> {
+    auto top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return std::nullopt;
+    }
+
+    const auto value = _buffer.load(std::memory_order_acquire)->load(top);
+
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+
+    return value;
+  }
+
+private:
+
+  alignas(cache_line_size_v) std::atomic<std::int64_t> _top{0};
+  alignas(cache_line_size_v) std::atomic<std::int64_t> _bottom{0};
+  std::atomic<buffer*> _buffer{nullptr};
+  std::vector<std::unique_ptr<buffer>> _buffers;
+
+}; // class work_stealing_queue
+
+} // namespace ecs
+
+#endif // LIBECS_WORK_STEALING_QUEUE_HPP_